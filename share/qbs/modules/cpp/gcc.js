@@ -1069,6 +1069,13 @@ function prepareCompiler(project, product, inputs, outputs, input, output, expli
         args = wrapperArgs.concat(args);
     }
 
+    var dependencyFilePath;
+    if (input.cpp.useCompilerDependencyFiles && !product.qbs.toolchain.contains("qcc")) {
+        dependencyFilePath = output.filePath + ".d";
+        args.push(input.cpp.treatSystemHeadersAsDependencies ? "-MD" : "-MMD",
+                  "-MF", dependencyFilePath);
+    }
+
     var cmd = new Command(compilerPath, args);
     cmd.description = (pchOutput ? 'pre' : '') + 'compiling ' + input.fileName;
     if (pchOutput)
@@ -1080,6 +1087,8 @@ function prepareCompiler(project, product, inputs, outputs, input, output, expli
         cmd.environment = extraEnv;
     cmd.responseFileArgumentIndex = wrapperArgsLength;
     cmd.responseFileUsagePrefix = '@';
+    if (dependencyFilePath)
+        cmd.dependencyFilePath = dependencyFilePath;
     setResponseFileThreshold(cmd, product);
     return cmd;
 }
@@ -40,6 +40,7 @@
 
 #include "application.h"
 #include "consoleprogressobserver.h"
+#include "filewatcher.h"
 #include "status.h"
 #include "parser/commandlineoption.h"
 #include "../shared/logging/consolelogger.h"
@@ -133,6 +134,15 @@ void CommandLineFrontend::start()
             break;
         }
 
+        if (m_parser.watch()) {
+            if (!FileWatcher::isSupported())
+                throw ErrorInfo(Tr::tr("Option '--watch' is not supported on this platform."));
+            if (m_parser.buildConfigurations().size() > 1) {
+                throw ErrorInfo(Tr::tr("Option '--watch' cannot be used with more than one "
+                                       "build configuration."));
+            }
+        }
+
         if (m_parser.showVersion()) {
             puts(QBS_VERSION);
             qApp->exit(EXIT_SUCCESS);
@@ -145,6 +155,7 @@ void CommandLineFrontend::start()
         params.setProjectFilePath(m_parser.projectFilePath());
         params.setDryRun(m_parser.dryRun());
         params.setForceProbeExecution(m_parser.forceProbesExecution());
+        params.setConcurrentProbeExecution(m_parser.concurrentProbeExecution());
         params.setWaitLockBuildGraph(m_parser.waitLockBuildGraph());
         params.setLogElapsedTime(m_parser.logTime());
         params.setSettingsDirectory(m_settings->baseDirectory());
@@ -176,6 +187,8 @@ void CommandLineFrontend::start()
             params.setConfigurationName(configurationName);
             params.setBuildRoot(buildDirectory(profileName));
             params.setOverriddenValues(userConfig);
+            if (m_parser.watch())
+                m_setupParameters = params;
             SetupProjectJob * const job = Project().setupProject(params,
                     ConsoleLogger::instance().logSink(), this);
             connectJob(job);
@@ -225,12 +238,20 @@ void CommandLineFrontend::handleJobFinished(bool success, AbstractJob *job)
             m_resolveJobs.removeOne(job);
             m_buildJobs.removeOne(job);
             if (m_resolveJobs.empty() && m_buildJobs.empty()) {
-                qApp->exit(EXIT_FAILURE);
+                if (!isWatching()) {
+                    qApp->exit(EXIT_FAILURE);
+                    return;
+                }
+                if (qobject_cast<SetupProjectJob *>(job))
+                    m_resolveFailed = true;
+                processFileChanges();
                 return;
             }
             cancel();
         } else if (SetupProjectJob * const setupJob = qobject_cast<SetupProjectJob *>(job)) {
             m_resolveJobs.removeOne(job);
+            if (m_parser.watch())
+                m_projects.clear(); // Resolved again after a change.
             m_projects.push_back(setupJob->project());
             if (m_observer && resolvingMultipleProjects())
                 m_observer->incrementProgressValue();
@@ -254,6 +275,11 @@ void CommandLineFrontend::handleJobFinished(bool success, AbstractJob *job)
                     // fall through
                 case BuildCommandType:
                 case CleanCommandType:
+                    if (isWatching()) {
+                        watchProject(); // The build may have found new dependencies.
+                        processFileChanges();
+                        break;
+                    }
                     qApp->exit(m_cancelStatus == CancelStatusNone ? EXIT_SUCCESS : EXIT_FAILURE);
                     break;
                 default:
@@ -336,6 +362,128 @@ bool CommandLineFrontend::isBuilding() const
     return !m_buildJobs.empty();
 }
 
+bool CommandLineFrontend::isWatching() const
+{
+    return m_fileWatcher && m_cancelStatus == CancelStatusNone;
+}
+
+void CommandLineFrontend::watchProject()
+{
+    if (!m_fileWatcher) {
+        m_fileWatcher = new FileWatcher(this);
+        connect(m_fileWatcher, &FileWatcher::filesChanged,
+                this, &CommandLineFrontend::handleFilesChanged);
+        connect(m_fileWatcher, &FileWatcher::eventsLost, this, [this] {
+            m_resolveFailed = false;
+            m_resolveNeeded = true;
+            m_fullCheckNeeded = true;
+            handleFilesChanged(QStringList(), QStringList());
+        });
+    }
+
+    const Project &project = m_projects.front();
+    m_watchedSourceFiles.clear();
+    const auto products = project.projectData().allProducts();
+    for (const ProductData &product : products) {
+        const auto groups = product.groups();
+        for (const GroupData &group : groups) {
+            const auto filePaths = group.allFilePaths();
+            for (const QString &filePath : filePaths)
+                m_watchedSourceFiles.insert(filePath);
+        }
+    }
+    m_buildSystemFiles = project.buildSystemFiles();
+    m_wildcardDirectories = project.wildcardDirectories();
+
+    std::set<QString> dirPaths = m_wildcardDirectories;
+    for (const QString &filePath : qAsConst(m_watchedSourceFiles))
+        dirPaths.insert(QFileInfo(filePath).path());
+    for (const QString &filePath : m_buildSystemFiles)
+        dirPaths.insert(QFileInfo(filePath).path());
+
+    // Headers and the like. Directories in the build directory are left out, as the build
+    // itself writes there.
+    const QString buildDirPrefix = project.projectData().buildDirectory() + QLatin1Char('/');
+    for (const QString &filePath : project.scannedDependencies()) {
+        const QString dirPath = QFileInfo(filePath).path();
+        if (!(dirPath + QLatin1Char('/')).startsWith(buildDirPrefix))
+            dirPaths.insert(dirPath);
+    }
+    m_fileWatcher->watchDirectories(dirPaths);
+}
+
+void CommandLineFrontend::handleFilesChanged(const QStringList &modifiedFiles,
+                                             const QStringList &addedOrRemovedFiles)
+{
+    if (m_resolveFailed && (!modifiedFiles.empty() || !addedOrRemovedFiles.empty())) {
+        m_resolveFailed = false;
+        m_resolveNeeded = true; // Try again with the next change, whatever it is.
+    }
+    // Files that are neither source files nor project files can be headers or other
+    // dependencies that only the dependency scanners know about. The build then has to
+    // check all timestamps.
+    for (const QString &filePath : modifiedFiles) {
+        if (m_buildSystemFiles.count(filePath) > 0)
+            m_resolveNeeded = true;
+        else if (m_watchedSourceFiles.contains(filePath))
+            m_pendingChangedFiles.insert(filePath);
+        else
+            m_fullCheckNeeded = true;
+    }
+    for (const QString &filePath : addedOrRemovedFiles) {
+        if (m_buildSystemFiles.count(filePath) > 0) {
+            m_resolveNeeded = true;
+        } else if (m_watchedSourceFiles.contains(filePath)) {
+            // Editors often save a file by replacing it.
+            if (QFileInfo::exists(filePath))
+                m_pendingChangedFiles.insert(filePath);
+            else
+                m_resolveNeeded = true;
+        } else if (m_wildcardDirectories.count(QFileInfo(filePath).path()) > 0) {
+            m_resolveNeeded = true;
+        } else {
+            m_fullCheckNeeded = true;
+        }
+    }
+    try {
+        processFileChanges();
+    } catch (const ErrorInfo &error) {
+        qbsError() << error.toString();
+        qApp->exit(EXIT_FAILURE);
+    }
+}
+
+// Starts the next build in watch mode, if there were relevant changes and no job is running.
+// The build only looks at the source files reported as changed. If there are none, e.g. because
+// only a project file changed, an empty list makes the build check all timestamps, as usual.
+void CommandLineFrontend::processFileChanges()
+{
+    if (isResolving() || isBuilding())
+        return; // We get called again when the job has finished.
+    if (m_resolveFailed
+            || (!m_resolveNeeded && !m_fullCheckNeeded && m_pendingChangedFiles.empty())) {
+        if (!m_waitingForChanges)
+            qbsInfo() << Tr::tr("Waiting for changes...");
+        m_waitingForChanges = true;
+        return;
+    }
+    m_waitingForChanges = false;
+    m_rebuildingAfterChanges = true;
+    m_changedFiles = m_fullCheckNeeded ? QStringList() : m_pendingChangedFiles.toList();
+    m_pendingChangedFiles.clear();
+    m_fullCheckNeeded = false;
+    if (!m_resolveNeeded) {
+        build();
+        return;
+    }
+    m_resolveNeeded = false;
+    qbsInfo() << Tr::tr("Project changed, resolving again.");
+    SetupProjectJob * const job = m_projects.front().setupProject(m_setupParameters,
+            ConsoleLogger::instance().logSink(), this);
+    connectJob(job);
+    m_resolveJobs.push_back(job);
+}
+
 CommandLineFrontend::ProductMap CommandLineFrontend::productsToUse() const
 {
     ProductMap products;
@@ -394,6 +542,8 @@ void CommandLineFrontend::handleProjectsResolved()
         checkGeneratorName();
         Q_FALLTHROUGH();
     case BuildCommandType:
+        if (m_parser.watch())
+            watchProject();
         build();
         break;
     case InstallCommandType:
@@ -417,6 +567,7 @@ void CommandLineFrontend::handleProjectsResolved()
         break;
     case HelpCommandType:
     case VersionCommandType:
+    case SessionCommandType:
         Q_ASSERT_X(false, Q_FUNC_INFO, "Impossible.");
     }
 }
@@ -460,6 +611,8 @@ int CommandLineFrontend::runShell()
 BuildOptions CommandLineFrontend::buildOptions(const Project &project) const
 {
     BuildOptions options = m_parser.buildOptions(m_projects.front().profile());
+    if (m_rebuildingAfterChanges)
+        options.setChangedFiles(m_changedFiles);
     if (options.maxJobCount() <= 0) {
         const QString profileName = project.profile();
         QBS_CHECK(!profileName.isEmpty());
@@ -42,12 +42,15 @@
 #include "parser/commandlineparser.h"
 #include <api/project.h>
 #include <api/projectdata.h>
+#include <tools/setupprojectparameters.h>
 
 #include <QtCore/qhash.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qobject.h>
+#include <QtCore/qset.h>
 
 #include <memory>
+#include <set>
 
 QT_BEGIN_NAMESPACE
 class QTimer;
@@ -57,6 +60,7 @@ namespace qbs {
 class AbstractJob;
 class ConsoleProgressObserver;
 class ErrorInfo;
+class FileWatcher;
 class ProcessResult;
 class ProjectGenerator;
 class Settings;
@@ -80,6 +84,8 @@ private:
     void handleTaskProgress(int value, qbs::AbstractJob *job);
     void handleProcessResultReport(const qbs::ProcessResult &result);
     void checkCancelStatus();
+    void handleFilesChanged(const QStringList &modifiedFiles,
+                            const QStringList &addedOrRemovedFiles);
 
     typedef QHash<Project, QList<ProductData> > ProductMap;
     ProductMap productsToUse() const;
@@ -87,6 +93,9 @@ private:
     bool resolvingMultipleProjects() const;
     bool isResolving() const;
     bool isBuilding() const;
+    bool isWatching() const;
+    void watchProject();
+    void processFileChanges();
     void handleProjectsResolved();
     void makeClean();
     int runShell();
@@ -123,6 +132,20 @@ private:
     int m_currentBuildEffort;
     QHash<AbstractJob *, int> m_buildEfforts;
     std::shared_ptr<ProjectGenerator> m_generator;
+
+    // For the --watch option.
+    SetupProjectParameters m_setupParameters;
+    FileWatcher *m_fileWatcher = nullptr;
+    QSet<QString> m_watchedSourceFiles;
+    std::set<QString> m_buildSystemFiles;
+    std::set<QString> m_wildcardDirectories;
+    QSet<QString> m_pendingChangedFiles;
+    QStringList m_changedFiles;
+    bool m_resolveNeeded = false;
+    bool m_resolveFailed = false;
+    bool m_fullCheckNeeded = false;
+    bool m_rebuildingAfterChanges = false;
+    bool m_waitingForChanges = false;
 };
 
 } // namespace qbs
@@ -0,0 +1,171 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "filewatcher.h"
+
+#include <logging/translator.h>
+#include <tools/error.h>
+
+#include <QtCore/qfile.h>
+#include <QtCore/qsocketnotifier.h>
+#include <QtCore/qtimer.h>
+
+#ifdef Q_OS_LINUX
+#include <sys/inotify.h>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#endif
+
+namespace qbs {
+using namespace Internal;
+
+FileWatcher::FileWatcher(QObject *parent)
+    : QObject(parent), m_reportTimer(new QTimer(this))
+{
+    m_reportTimer->setSingleShot(true);
+    m_reportTimer->setInterval(200);
+    connect(m_reportTimer, &QTimer::timeout, this, &FileWatcher::reportChanges);
+}
+
+FileWatcher::~FileWatcher()
+{
+#ifdef Q_OS_LINUX
+    if (m_fd != -1)
+        ::close(m_fd);
+#endif
+}
+
+bool FileWatcher::isSupported()
+{
+#ifdef Q_OS_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FileWatcher::watchDirectories(const std::set<QString> &dirPaths)
+{
+#ifdef Q_OS_LINUX
+    if (m_fd == -1) {
+        m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_fd == -1) {
+            throw ErrorInfo(Tr::tr("Cannot watch for file changes: %1")
+                            .arg(QString::fromLocal8Bit(std::strerror(errno))));
+        }
+        m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+        connect(m_notifier, &QSocketNotifier::activated, this, &FileWatcher::readEvents);
+    }
+
+    // Adding a watch for a directory that is already watched returns the existing descriptor.
+    QHash<int, QString> watchedDirectories;
+    const uint32_t mask = IN_CLOSE_WRITE | IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM
+            | IN_MOVED_TO | IN_ONLYDIR;
+    for (const QString &dirPath : dirPaths) {
+        const int wd = inotify_add_watch(m_fd, QFile::encodeName(dirPath).constData(), mask);
+        if (wd == -1) {
+            if (errno == ENOENT || errno == ENOTDIR)
+                continue;
+            throw ErrorInfo(Tr::tr("Cannot watch directory '%1' for changes: %2")
+                            .arg(dirPath, QString::fromLocal8Bit(std::strerror(errno))));
+        }
+        watchedDirectories.insert(wd, dirPath);
+    }
+    for (auto it = m_watchedDirectories.cbegin(); it != m_watchedDirectories.cend(); ++it) {
+        if (!watchedDirectories.contains(it.key()))
+            inotify_rm_watch(m_fd, it.key());
+    }
+    m_watchedDirectories = watchedDirectories;
+#else
+    Q_UNUSED(dirPaths);
+    throw ErrorInfo(Tr::tr("Watching for file changes is not supported on this platform."));
+#endif
+}
+
+void FileWatcher::readEvents()
+{
+#ifdef Q_OS_LINUX
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        const ssize_t length = ::read(m_fd, buffer, sizeof buffer);
+        if (length <= 0)
+            break;
+        for (const char *p = buffer; p < buffer + length; ) {
+            const auto event = reinterpret_cast<const inotify_event *>(p);
+            p += sizeof(inotify_event) + event->len;
+            if (event->mask & IN_Q_OVERFLOW) {
+                m_modifiedFiles.clear();
+                m_addedOrRemovedFiles.clear();
+                m_reportTimer->stop();
+                emit eventsLost();
+                continue;
+            }
+            if (event->mask & IN_IGNORED) { // The directory is gone.
+                m_watchedDirectories.remove(event->wd);
+                continue;
+            }
+            if (event->len == 0)
+                continue;
+            const auto dirIt = m_watchedDirectories.constFind(event->wd);
+            if (dirIt == m_watchedDirectories.constEnd())
+                continue;
+            const QString filePath = dirIt.value() + QLatin1Char('/')
+                    + QFile::decodeName(event->name);
+            if (event->mask & (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO))
+                m_addedOrRemovedFiles.insert(filePath);
+            else
+                m_modifiedFiles.insert(filePath);
+        }
+    }
+    if (!m_modifiedFiles.empty() || !m_addedOrRemovedFiles.empty())
+        m_reportTimer->start();
+#endif
+}
+
+void FileWatcher::reportChanges()
+{
+    const QStringList modifiedFiles = m_modifiedFiles.toList();
+    const QStringList addedOrRemovedFiles = m_addedOrRemovedFiles.toList();
+    m_modifiedFiles.clear();
+    m_addedOrRemovedFiles.clear();
+    emit filesChanged(modifiedFiles, addedOrRemovedFiles);
+}
+
+} // namespace qbs
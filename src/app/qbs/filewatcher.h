@@ -0,0 +1,92 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QBS_FILEWATCHER_H
+#define QBS_FILEWATCHER_H
+
+#include <QtCore/qhash.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qset.h>
+#include <QtCore/qstringlist.h>
+
+#include <set>
+
+QT_BEGIN_NAMESPACE
+class QSocketNotifier;
+class QTimer;
+QT_END_NAMESPACE
+
+namespace qbs {
+
+// Reports changes to the entries of a set of directories. Events arriving in quick succession,
+// as when an editor saves several files, are reported together.
+// Only implemented on Linux, where it uses inotify.
+class FileWatcher : public QObject
+{
+    Q_OBJECT
+public:
+    explicit FileWatcher(QObject *parent = nullptr);
+    ~FileWatcher() override;
+
+    static bool isSupported();
+
+    // Replaces the set of watched directories. Throws ErrorInfo on failure.
+    void watchDirectories(const std::set<QString> &dirPaths);
+
+signals:
+    void filesChanged(const QStringList &modifiedFiles, const QStringList &addedOrRemovedFiles);
+
+    // Changes were lost, because they came in faster than they could be processed.
+    void eventsLost();
+
+private:
+    void readEvents();
+    void reportChanges();
+
+    int m_fd = -1;
+    QSocketNotifier *m_notifier = nullptr;
+    QTimer * const m_reportTimer;
+    QHash<int, QString> m_watchedDirectories;
+    QSet<QString> m_modifiedFiles;
+    QSet<QString> m_addedOrRemovedFiles;
+};
+
+} // namespace qbs
+
+#endif // QBS_FILEWATCHER_H
@@ -40,6 +40,7 @@
 #include "application.h"
 #include "commandlinefrontend.h"
 #include "qbstool.h"
+#include "session.h"
 #include "parser/commandlineparser.h"
 #include "../shared/logging/consolelogger.h"
 
@@ -85,6 +86,11 @@ int main(int argc, char *argv[])
 
         Settings settings(parser.settingsDir());
         ConsoleLogger::instance().setSettings(&settings);
+        if (parser.command() == SessionCommandType) {
+            Session session(&settings);
+            QTimer::singleShot(0, &session, &Session::start);
+            return app.exec();
+        }
         CommandLineFrontend clFrontend(parser, &settings);
         app.setCommandLineFrontend(&clFrontend);
         QTimer::singleShot(0, &clFrontend, &CommandLineFrontend::start);
@@ -290,6 +290,19 @@ QString ForceProbesOption::longRepresentation() const
     return QLatin1String("--force-probe-execution");
 }
 
+QString ConcurrentProbesOption::description(CommandType command) const
+{
+    Q_UNUSED(command);
+    return Tr::tr("%1\n"
+            "\tRun the configure scripts of a product's Probe items in parallel.\n")
+            .arg(longRepresentation());
+}
+
+QString ConcurrentProbesOption::longRepresentation() const
+{
+    return QLatin1String("--concurrent-probe-execution");
+}
+
 QString NoInstallOption::description(CommandType command) const
 {
     Q_UNUSED(command);
@@ -627,6 +640,32 @@ QString RespectProjectJobLimitsOption::longRepresentation() const
     return QLatin1String("--enforce-project-job-limits");
 }
 
+QString CriticalPathSchedulingOption::description(CommandType command) const
+{
+    Q_UNUSED(command);
+    return Tr::tr("%1\n\tRun commands that start the longest remaining chain of work first.\n"
+                  "\tThe cost of a command is estimated from its duration in the previous build.\n")
+            .arg(longRepresentation());
+}
+
+QString CriticalPathSchedulingOption::longRepresentation() const
+{
+    return QLatin1String("--critical-path-scheduling");
+}
+
+QString ContentHashCheckOption::description(CommandType command) const
+{
+    Q_UNUSED(command);
+    return Tr::tr("%1\n\tDo not rebuild targets whose inputs changed only in their timestamps.\n"
+                  "\tContent digests of inputs are recorded in the build graph for comparison.\n")
+            .arg(longRepresentation());
+}
+
+QString ContentHashCheckOption::longRepresentation() const
+{
+    return QLatin1String("--check-content-hashes");
+}
+
 CommandEchoModeOption::CommandEchoModeOption()
 {
 }
@@ -693,4 +732,18 @@ QString RunEnvConfigOption::longRepresentation() const
     return QLatin1String("--setup-run-env-config");
 }
 
+QString WatchOption::description(CommandType command) const
+{
+    Q_UNUSED(command);
+    return Tr::tr("%1\n"
+                  "\tAfter building, wait for source files or project files to change "
+                  "and build again.\n"
+                  "\tOnly supported on Linux.\n").arg(longRepresentation());
+}
+
+QString WatchOption::longRepresentation() const
+{
+    return QLatin1String("--watch");
+}
+
 } // namespace qbs
@@ -59,6 +59,7 @@ public:
         KeepGoingOptionType,
         DryRunOptionType,
         ForceProbesOptionType,
+        ConcurrentProbesOptionType,
         ShowProgressOptionType,
         ChangedFilesOptionType,
         ProductsOptionType,
@@ -72,9 +73,12 @@ public:
         SettingsDirOptionType,
         JobLimitsOptionType,
         RespectProjectJobLimitsOptionType,
+        CriticalPathSchedulingOptionType,
+        ContentHashCheckOptionType,
         GeneratorOptionType,
         WaitLockOptionType,
         RunEnvConfigOptionType,
+        WatchOptionType,
     };
 
     virtual ~CommandLineOption();
@@ -222,6 +226,13 @@ class ForceProbesOption : public OnOffOption
     QString longRepresentation() const override;
 };
 
+class ConcurrentProbesOption : public OnOffOption
+{
+    QString description(CommandType command) const override;
+    QString shortRepresentation() const override { return QString(); }
+    QString longRepresentation() const override;
+};
+
 class NoInstallOption : public OnOffOption
 {
     QString description(CommandType command) const override;
@@ -406,6 +417,22 @@ public:
     QString longRepresentation() const override;
 };
 
+class CriticalPathSchedulingOption : public OnOffOption
+{
+public:
+    QString description(CommandType command) const override;
+    QString shortRepresentation() const override { return QString(); }
+    QString longRepresentation() const override;
+};
+
+class ContentHashCheckOption : public OnOffOption
+{
+public:
+    QString description(CommandType command) const override;
+    QString shortRepresentation() const override { return QString(); }
+    QString longRepresentation() const override;
+};
+
 class WaitLockOption : public OnOffOption
 {
 public:
@@ -414,6 +441,14 @@ public:
     QString longRepresentation() const override;
 };
 
+class WatchOption : public OnOffOption
+{
+public:
+    QString description(CommandType command) const override;
+    QString shortRepresentation() const override { return QString(); }
+    QString longRepresentation() const override;
+};
+
 } // namespace qbs
 
 #endif // QBS_COMMANDLINEOPTION_H
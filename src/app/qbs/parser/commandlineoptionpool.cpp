@@ -77,6 +77,9 @@ CommandLineOption *CommandLineOptionPool::getOption(CommandLineOption::Type type
         case CommandLineOption::ForceProbesOptionType:
             option = new ForceProbesOption;
             break;
+        case CommandLineOption::ConcurrentProbesOptionType:
+            option = new ConcurrentProbesOption;
+            break;
         case CommandLineOption::ShowProgressOptionType:
             option = new ShowProgressOption;
             break;
@@ -122,6 +125,12 @@ CommandLineOption *CommandLineOptionPool::getOption(CommandLineOption::Type type
         case CommandLineOption::RespectProjectJobLimitsOptionType:
             option = new RespectProjectJobLimitsOption;
             break;
+        case CommandLineOption::CriticalPathSchedulingOptionType:
+            option = new CriticalPathSchedulingOption;
+            break;
+        case CommandLineOption::ContentHashCheckOptionType:
+            option = new ContentHashCheckOption;
+            break;
         case CommandLineOption::GeneratorOptionType:
             option = new GeneratorOption;
             break;
@@ -131,6 +140,9 @@ CommandLineOption *CommandLineOptionPool::getOption(CommandLineOption::Type type
         case CommandLineOption::RunEnvConfigOptionType:
             option = new RunEnvConfigOption;
             break;
+        case CommandLineOption::WatchOptionType:
+            option = new WatchOption;
+            break;
         default:
             qFatal("Unknown option type %d", type);
         }
@@ -178,6 +190,12 @@ ForceProbesOption *CommandLineOptionPool::forceProbesOption() const
     return static_cast<ForceProbesOption *>(getOption(CommandLineOption::ForceProbesOptionType));
 }
 
+ConcurrentProbesOption *CommandLineOptionPool::concurrentProbesOption() const
+{
+    return static_cast<ConcurrentProbesOption *>(
+                getOption(CommandLineOption::ConcurrentProbesOptionType));
+}
+
 ChangedFilesOption *CommandLineOptionPool::changedFilesOption() const
 {
     return static_cast<ChangedFilesOption *>(getOption(CommandLineOption::ChangedFilesOptionType));
@@ -263,6 +281,18 @@ RespectProjectJobLimitsOption *CommandLineOptionPool::respectProjectJobLimitsOpt
                 getOption(CommandLineOption::RespectProjectJobLimitsOptionType));
 }
 
+CriticalPathSchedulingOption *CommandLineOptionPool::criticalPathSchedulingOption() const
+{
+    return static_cast<CriticalPathSchedulingOption *>(
+                getOption(CommandLineOption::CriticalPathSchedulingOptionType));
+}
+
+ContentHashCheckOption *CommandLineOptionPool::contentHashCheckOption() const
+{
+    return static_cast<ContentHashCheckOption *>(
+                getOption(CommandLineOption::ContentHashCheckOptionType));
+}
+
 GeneratorOption *CommandLineOptionPool::generatorOption() const
 {
     return static_cast<GeneratorOption *>(getOption(CommandLineOption::GeneratorOptionType));
@@ -278,4 +308,9 @@ RunEnvConfigOption *CommandLineOptionPool::runEnvConfigOption() const
     return static_cast<RunEnvConfigOption *>(getOption(CommandLineOption::RunEnvConfigOptionType));
 }
 
+WatchOption *CommandLineOptionPool::watchOption() const
+{
+    return static_cast<WatchOption *>(getOption(CommandLineOption::WatchOptionType));
+}
+
 } // namespace qbs
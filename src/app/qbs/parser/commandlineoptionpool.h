@@ -59,6 +59,7 @@ public:
     ShowProgressOption *showProgressOption() const;
     DryRunOption *dryRunOption() const;
     ForceProbesOption *forceProbesOption() const;
+    ConcurrentProbesOption *concurrentProbesOption() const;
     ChangedFilesOption *changedFilesOption() const;
     KeepGoingOption *keepGoingOption() const;
     JobsOption *jobsOption() const;
@@ -75,9 +76,12 @@ public:
     SettingsDirOption *settingsDirOption() const;
     JobLimitsOption *jobLimitsOption() const;
     RespectProjectJobLimitsOption *respectProjectJobLimitsOption() const;
+    CriticalPathSchedulingOption *criticalPathSchedulingOption() const;
+    ContentHashCheckOption *contentHashCheckOption() const;
     GeneratorOption *generatorOption() const;
     WaitLockOption *waitLockOption() const;
     RunEnvConfigOption *runEnvConfigOption() const;
+    WatchOption *watchOption() const;
 
 private:
     mutable QHash<CommandLineOption::Type, CommandLineOption *> m_options;
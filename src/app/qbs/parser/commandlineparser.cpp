@@ -226,11 +226,21 @@ bool CommandLineParser::forceProbesExecution() const
     return d->optionPool.forceProbesOption()->enabled();
 }
 
+bool CommandLineParser::concurrentProbeExecution() const
+{
+    return d->optionPool.concurrentProbesOption()->enabled();
+}
+
 bool CommandLineParser::waitLockBuildGraph() const
 {
     return d->optionPool.waitLockOption()->enabled();
 }
 
+bool CommandLineParser::watch() const
+{
+    return d->optionPool.watchOption()->enabled();
+}
+
 bool CommandLineParser::logTime() const
 {
     return d->logTime;
@@ -346,8 +356,10 @@ void CommandLineParser::CommandLineParserPrivate::doParse()
     }
     command->parse(commandLine);
 
-    if (command->type() == HelpCommandType || command->type() == VersionCommandType)
+    if (command->type() == HelpCommandType || command->type() == VersionCommandType
+            || command->type() == SessionCommandType) {
         return;
+    }
 
     setupBuildDirectory();
     setupBuildConfigurations();
@@ -381,6 +393,7 @@ QList<Command *> CommandLineParser::CommandLineParserPrivate::allCommands() cons
             << commandPool.getCommand(InstallCommandType)
             << commandPool.getCommand(DumpNodesTreeCommandType)
             << commandPool.getCommand(ListProductsCommandType)
+            << commandPool.getCommand(SessionCommandType)
             << commandPool.getCommand(VersionCommandType)
             << commandPool.getCommand(HelpCommandType);
 }
@@ -465,6 +478,8 @@ void CommandLineParser::CommandLineParserPrivate::setupBuildOptions()
     buildOptions.setJobLimits(optionPool.jobLimitsOption()->jobLimits());
     buildOptions.setProjectJobLimitsTakePrecedence(
                 optionPool.respectProjectJobLimitsOption()->enabled());
+    buildOptions.setCriticalPathScheduling(optionPool.criticalPathSchedulingOption()->enabled());
+    buildOptions.setContentHashCheck(optionPool.contentHashCheckOption()->enabled());
     buildOptions.setSettingsDirectory(settingsDir());
 }
 
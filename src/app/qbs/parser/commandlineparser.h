@@ -75,7 +75,9 @@ public:
     bool forceOutputCheck() const;
     bool dryRun() const;
     bool forceProbesExecution() const;
+    bool concurrentProbeExecution() const;
     bool waitLockBuildGraph() const;
+    bool watch() const;
     bool logTime() const;
     bool withNonDefaultProducts() const;
     bool buildBeforeInstalling() const;
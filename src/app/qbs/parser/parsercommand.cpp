@@ -210,6 +210,7 @@ static QList<CommandLineOption::Type> resolveOptions()
             << CommandLineOption::ShowProgressOptionType
             << CommandLineOption::DryRunOptionType
             << CommandLineOption::ForceProbesOptionType
+            << CommandLineOption::ConcurrentProbesOptionType
             << CommandLineOption::LogTimeOptionType;
 }
 
@@ -287,12 +288,14 @@ static QList<CommandLineOption::Type> buildOptions()
             << CommandLineOption::RemoveFirstOptionType
             << CommandLineOption::JobLimitsOptionType
             << CommandLineOption::RespectProjectJobLimitsOptionType
+            << CommandLineOption::CriticalPathSchedulingOptionType
+            << CommandLineOption::ContentHashCheckOptionType
             << CommandLineOption::WaitLockOptionType;
 }
 
 QList<CommandLineOption::Type> BuildCommand::supportedOptions() const
 {
-    return buildOptions();
+    return buildOptions() << CommandLineOption::WatchOptionType;
 }
 
 QString CleanCommand::shortDescription() const
@@ -573,6 +576,39 @@ void HelpCommand::parseNext(QStringList &input)
     QBS_CHECK(input.empty());
 }
 
+QString SessionCommand::shortDescription() const
+{
+    return Tr::tr("Serve requests from an IDE or other tool, keeping the project loaded.");
+}
+
+QString SessionCommand::longDescription() const
+{
+    QString description = Tr::tr("qbs %1 [options]\n").arg(representation());
+    description += Tr::tr("Reads requests from stdin and writes replies to stdout, "
+                          "one JSON object per line.\n"
+                          "The project stays in memory between requests, so that subsequent "
+                          "builds do not need to load it again.\n");
+    return description += supportedOptionsDescription();
+}
+
+QString SessionCommand::representation() const
+{
+    return QLatin1String("session");
+}
+
+QList<CommandLineOption::Type> SessionCommand::supportedOptions() const
+{
+    return QList<CommandLineOption::Type>();
+}
+
+void SessionCommand::parseNext(QStringList &input)
+{
+    QBS_CHECK(!input.empty());
+    if (!input.front().startsWith(QLatin1Char('-')))
+        throwError(Tr::tr("This command takes no arguments."));
+    Command::parseNext(input);
+}
+
 QString VersionCommand::shortDescription() const
 {
     return Tr::tr("Print the Qbs version number to stdout.");
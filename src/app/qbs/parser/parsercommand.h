@@ -247,6 +247,20 @@ private:
     QString m_command;
 };
 
+class SessionCommand : public Command
+{
+public:
+    SessionCommand(CommandLineOptionPool &optionPool) : Command(optionPool) {}
+
+private:
+    CommandType type() const override { return SessionCommandType; }
+    QString shortDescription() const override;
+    QString longDescription() const override;
+    QString representation() const override;
+    QList<CommandLineOption::Type> supportedOptions() const override;
+    void parseNext(QStringList &input) override;
+};
+
 class VersionCommand : public Command
 {
 public:
@@ -9,7 +9,10 @@ SOURCES += main.cpp \
     status.cpp \
     consoleprogressobserver.cpp \
     commandlinefrontend.cpp \
-    qbstool.cpp
+    filewatcher.cpp \
+    qbstool.cpp \
+    session.cpp \
+    stdinreader.cpp
 
 HEADERS += \
     ctrlchandler.h \
@@ -17,7 +20,10 @@ HEADERS += \
     status.h \
     consoleprogressobserver.h \
     commandlinefrontend.h \
-    qbstool.h
+    filewatcher.h \
+    qbstool.h \
+    session.h \
+    stdinreader.h
 
 include(../../library_dirname.pri)
 isEmpty(QBS_RELATIVE_LIBEXEC_PATH) {
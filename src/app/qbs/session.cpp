@@ -0,0 +1,388 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "session.h"
+
+#include "stdinreader.h"
+#include "../shared/logging/consolelogger.h"
+
+#include <qbs.h>
+#include <logging/translator.h>
+#include <tools/qbsassert.h>
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+
+#include <cstdio>
+#include <functional>
+
+namespace qbs {
+using namespace Internal;
+
+static QJsonObject errorToJson(const ErrorInfo &error)
+{
+    QJsonArray items;
+    const QList<ErrorItem> errorItems = error.items();
+    for (const ErrorItem &errorItem : errorItems) {
+        QJsonObject item;
+        item.insert(QStringLiteral("description"), errorItem.description());
+        const CodeLocation location = errorItem.codeLocation();
+        if (location.isValid()) {
+            item.insert(QStringLiteral("file-path"), location.filePath());
+            item.insert(QStringLiteral("line"), location.line());
+            item.insert(QStringLiteral("column"), location.column());
+        }
+        items.append(item);
+    }
+    return QJsonObject{{QStringLiteral("items"), items}};
+}
+
+class SessionLogSink : public ILogSink
+{
+public:
+    explicit SessionLogSink(const std::function<void(const QJsonObject &)> &sendPacket)
+        : m_sendPacket(sendPacket) {}
+
+private:
+    void doPrintMessage(LoggerLevel level, const QString &message, const QString &tag) override
+    {
+        m_sendPacket(QJsonObject{{QStringLiteral("type"), QStringLiteral("log-data")},
+                                 {QStringLiteral("level"), logLevelName(level)},
+                                 {QStringLiteral("message"), message},
+                                 {QStringLiteral("tag"), tag}});
+    }
+
+    void doPrintWarning(const ErrorInfo &warning) override
+    {
+        m_sendPacket(QJsonObject{{QStringLiteral("type"), QStringLiteral("warning")},
+                                 {QStringLiteral("warning"), errorToJson(warning)}});
+    }
+
+    const std::function<void(const QJsonObject &)> m_sendPacket;
+};
+
+Session::Session(Settings *settings, QObject *parent)
+    : QObject(parent)
+    , m_settings(settings)
+    , m_logSink(new SessionLogSink([this](const QJsonObject &packet) { sendPacket(packet); }))
+    , m_stdinReader(new StdinReader(this))
+{
+    connect(m_stdinReader, &StdinReader::lineRead, this, &Session::handleLine);
+    connect(m_stdinReader, &StdinReader::endOfInput, this, &Session::quitSession);
+}
+
+Session::~Session()
+{
+}
+
+void Session::start()
+{
+    if (!m_stdout.open(stdout, QIODevice::WriteOnly)) {
+        qbsError() << Tr::tr("Cannot write to stdout: %1").arg(m_stdout.errorString());
+        qApp->exit(EXIT_FAILURE);
+        return;
+    }
+    sendPacket(QJsonObject{{QStringLiteral("type"), QStringLiteral("hello")},
+                           {QStringLiteral("api-level"), 1}});
+    m_stdinReader->start();
+}
+
+void Session::handleLine(const QByteArray &line)
+{
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(line, &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        sendProtocolError(Tr::tr("Invalid request: %1").arg(parseError.errorString()));
+        return;
+    }
+    if (!document.isObject()) {
+        sendProtocolError(Tr::tr("Invalid request: Expected a JSON object."));
+        return;
+    }
+    handleRequest(document.object());
+}
+
+void Session::handleRequest(const QJsonObject &request)
+{
+    const QString type = request.value(QStringLiteral("type")).toString();
+    if (type == QLatin1String("cancel-job")) {
+        if (m_currentJob)
+            m_currentJob->cancel();
+        return;
+    }
+    if (type == QLatin1String("quit")) {
+        quitSession();
+        return;
+    }
+    if (m_quitRequested)
+        return;
+
+    void (Session::*handler)(const QJsonObject &) = nullptr;
+    if (type == QLatin1String("resolve-project"))
+        handler = &Session::resolveProject;
+    else if (type == QLatin1String("build-project"))
+        handler = &Session::buildProject;
+    else if (type == QLatin1String("clean-project"))
+        handler = &Session::cleanProject;
+    if (!handler) {
+        sendProtocolError(Tr::tr("Unknown request type '%1'.").arg(type));
+        return;
+    }
+    if (m_currentJob) {
+        sendProtocolError(Tr::tr("Cannot handle request of type '%1' while another request "
+                                 "is being handled.").arg(type));
+        return;
+    }
+    if (handler != &Session::resolveProject && !m_project.isValid()) {
+        sendProtocolError(Tr::tr("Cannot handle request of type '%1': "
+                                 "No project has been resolved.").arg(type));
+        return;
+    }
+    try {
+        (this->*handler)(request);
+    } catch (const ErrorInfo &error) {
+        sendPacket(QJsonObject{{QStringLiteral("type"), m_currentReplyType},
+                               {QStringLiteral("error"), errorToJson(error)}});
+    }
+}
+
+void Session::resolveProject(const QJsonObject &request)
+{
+    m_currentReplyType = QStringLiteral("project-resolved");
+    const QString projectFilePath = request.value(QStringLiteral("project-file-path")).toString();
+    const QString buildRoot = request.value(QStringLiteral("build-root")).toString();
+    if (projectFilePath.isEmpty() || buildRoot.isEmpty()) {
+        throw ErrorInfo(Tr::tr("A resolve request needs the properties 'project-file-path' "
+                               "and 'build-root'."));
+    }
+
+    const QString logLevelString = request.value(QStringLiteral("log-level")).toString();
+    if (!logLevelString.isEmpty()) {
+        bool found = false;
+        for (int level = LoggerMinLevel; level <= LoggerMaxLevel; ++level) {
+            if (logLevelName(static_cast<LoggerLevel>(level)) == logLevelString) {
+                m_logSink->setLogLevel(static_cast<LoggerLevel>(level));
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+            throw ErrorInfo(Tr::tr("Invalid log level '%1'.").arg(logLevelString));
+    }
+
+    SetupProjectParameters params;
+    params.setEnvironment(QProcessEnvironment::systemEnvironment());
+    params.setProjectFilePath(projectFilePath);
+    params.setBuildRoot(buildRoot);
+    params.setConfigurationName(request.value(QStringLiteral("configuration-name"))
+                                .toString(QStringLiteral("default")));
+    params.setTopLevelProfile(request.value(QStringLiteral("top-level-profile")).toString());
+    params.setOverriddenValues(request.value(QStringLiteral("overridden-properties"))
+                               .toObject().toVariantMap());
+    params.setDryRun(request.value(QStringLiteral("dry-run")).toBool());
+    params.setForceProbeExecution(request.value(QStringLiteral("force-probe-execution"))
+                                  .toBool());
+    params.setSettingsDirectory(m_settings->baseDirectory());
+    params.setPropertyCheckingMode(ErrorHandlingMode::Strict);
+    const Preferences prefs(m_settings);
+    const QString appDirPath = QCoreApplication::applicationDirPath();
+    params.setSearchPaths(prefs.searchPaths(QDir::cleanPath(appDirPath
+            + QLatin1String("/" QBS_RELATIVE_SEARCH_PATH))));
+    params.setPluginPaths(prefs.pluginPaths(QDir::cleanPath(appDirPath
+            + QLatin1String("/" QBS_RELATIVE_PLUGINS_PATH))));
+    params.setLibexecPath(QDir::cleanPath(appDirPath
+            + QLatin1String("/" QBS_RELATIVE_LIBEXEC_PATH)));
+
+    // Passing the current project makes the library check it for changes instead of
+    // loading the build graph from disk again.
+    startJob(m_project.setupProject(params, m_logSink.get(), this));
+}
+
+void Session::buildProject(const QJsonObject &request)
+{
+    m_currentReplyType = QStringLiteral("project-built");
+    BuildOptions options;
+    options.setSettingsDirectory(m_settings->baseDirectory());
+    options.setDryRun(request.value(QStringLiteral("dry-run")).toBool());
+    options.setKeepGoing(request.value(QStringLiteral("keep-going")).toBool());
+    options.setInstall(request.value(QStringLiteral("install")).toBool(options.install()));
+    options.setMaxJobCount(request.value(QStringLiteral("max-job-count")).toInt());
+    options.setChangedFiles(request.value(QStringLiteral("changed-files")).toVariant()
+                            .toStringList());
+    const QString echoModeString = request.value(QStringLiteral("command-echo-mode")).toString();
+    if (!echoModeString.isEmpty()) {
+        const CommandEchoMode echoMode = commandEchoModeFromName(echoModeString);
+        if (echoMode == CommandEchoModeInvalid)
+            throw ErrorInfo(Tr::tr("Invalid command echo mode '%1'.").arg(echoModeString));
+        options.setEchoMode(echoMode);
+    }
+
+    const QList<ProductData> products = productsFromRequest(request);
+    BuildJob * const job = products.empty()
+            ? m_project.buildAllProducts(options, Project::ProductSelectionDefaultOnly, this)
+            : m_project.buildSomeProducts(products, options, this);
+    connect(job, &BuildJob::reportCommandDescription, this, &Session::handleCommandDescription);
+    connect(job, &BuildJob::reportProcessResult, this, &Session::handleProcessResult);
+    startJob(job);
+}
+
+void Session::cleanProject(const QJsonObject &request)
+{
+    m_currentReplyType = QStringLiteral("project-cleaned");
+    CleanOptions options;
+    options.setDryRun(request.value(QStringLiteral("dry-run")).toBool());
+    options.setKeepGoing(request.value(QStringLiteral("keep-going")).toBool());
+    const QList<ProductData> products = productsFromRequest(request);
+    startJob(products.empty() ? m_project.cleanAllProducts(options, this)
+                              : m_project.cleanSomeProducts(products, options, this));
+}
+
+void Session::quitSession()
+{
+    m_quitRequested = true;
+    if (m_currentJob)
+        m_currentJob->cancel();
+    else
+        qApp->quit();
+}
+
+QList<ProductData> Session::productsFromRequest(const QJsonObject &request) const
+{
+    const QStringList productNames = request.value(QStringLiteral("products")).toVariant()
+            .toStringList();
+    QList<ProductData> products;
+    if (productNames.empty())
+        return products;
+    const QList<ProductData> allProducts = m_project.projectData().allProducts();
+    for (const QString &productName : productNames) {
+        bool found = false;
+        for (const ProductData &product : allProducts) {
+            if (product.name() == productName || product.fullDisplayName() == productName) {
+                products.push_back(product);
+                found = true;
+            }
+        }
+        if (!found)
+            throw ErrorInfo(Tr::tr("No such product '%1'.").arg(productName));
+    }
+    return products;
+}
+
+void Session::startJob(AbstractJob *job)
+{
+    m_currentJob = job;
+    connect(job, &AbstractJob::finished, this, &Session::handleJobFinished);
+    connect(job, &AbstractJob::taskStarted, this, &Session::handleTaskStarted);
+    connect(job, &AbstractJob::taskProgress, this, &Session::handleTaskProgress);
+}
+
+void Session::handleJobFinished(bool success, AbstractJob *job)
+{
+    QBS_CHECK(job == m_currentJob);
+    job->deleteLater();
+    m_currentJob = nullptr;
+    QJsonObject reply{{QStringLiteral("type"), m_currentReplyType}};
+    if (!success) {
+        reply.insert(QStringLiteral("error"), errorToJson(job->error()));
+    } else if (const auto setupJob = qobject_cast<SetupProjectJob *>(job)) {
+        m_project = setupJob->project();
+        QJsonArray productNames;
+        const QList<ProductData> products = m_project.projectData().allProducts();
+        for (const ProductData &product : products)
+            productNames.append(product.fullDisplayName());
+        reply.insert(QStringLiteral("products"), productNames);
+    }
+    sendPacket(reply);
+    if (m_quitRequested)
+        qApp->quit();
+}
+
+void Session::handleTaskStarted(const QString &description, int maximumProgressValue)
+{
+    sendPacket(QJsonObject{{QStringLiteral("type"), QStringLiteral("task-started")},
+                           {QStringLiteral("description"), description},
+                           {QStringLiteral("max-progress"), maximumProgressValue}});
+}
+
+void Session::handleTaskProgress(int newProgressValue)
+{
+    sendPacket(QJsonObject{{QStringLiteral("type"), QStringLiteral("task-progress")},
+                           {QStringLiteral("progress"), newProgressValue}});
+}
+
+void Session::handleCommandDescription(const QString &highlight, const QString &message)
+{
+    sendPacket(QJsonObject{{QStringLiteral("type"), QStringLiteral("command-description")},
+                           {QStringLiteral("highlight"), highlight},
+                           {QStringLiteral("message"), message}});
+}
+
+void Session::handleProcessResult(const ProcessResult &result)
+{
+    sendPacket(QJsonObject{{QStringLiteral("type"), QStringLiteral("process-result")},
+                           {QStringLiteral("executable-file-path"),
+                            result.executableFilePath()},
+                           {QStringLiteral("arguments"),
+                            QJsonArray::fromStringList(result.arguments())},
+                           {QStringLiteral("working-directory"), result.workingDirectory()},
+                           {QStringLiteral("success"), result.success()},
+                           {QStringLiteral("exit-code"), result.exitCode()},
+                           {QStringLiteral("stdout"), QJsonArray::fromStringList(result.stdOut())},
+                           {QStringLiteral("stderr"),
+                            QJsonArray::fromStringList(result.stdErr())}});
+}
+
+void Session::sendPacket(const QJsonObject &packet)
+{
+    std::lock_guard<std::mutex> lock(m_stdoutMutex);
+    m_stdout.write(QJsonDocument(packet).toJson(QJsonDocument::Compact));
+    m_stdout.write("\n");
+    m_stdout.flush();
+}
+
+void Session::sendProtocolError(const QString &message)
+{
+    sendPacket(QJsonObject{{QStringLiteral("type"), QStringLiteral("protocol-error")},
+                           {QStringLiteral("error"), errorToJson(ErrorInfo(message))}});
+}
+
+} // namespace qbs
@@ -0,0 +1,105 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QBS_SESSION_H
+#define QBS_SESSION_H
+
+#include <api/project.h>
+
+#include <QtCore/qfile.h>
+#include <QtCore/qobject.h>
+
+#include <memory>
+#include <mutex>
+
+QT_BEGIN_NAMESPACE
+class QJsonObject;
+QT_END_NAMESPACE
+
+namespace qbs {
+class AbstractJob;
+class ErrorInfo;
+class ProcessResult;
+class ProductData;
+class SessionLogSink;
+class Settings;
+class StdinReader;
+
+// Serves requests from a client such as an IDE. The resolved project is kept in memory,
+// so that building it again does not need to load the build graph from disk.
+class Session : public QObject
+{
+    Q_OBJECT
+public:
+    explicit Session(Settings *settings, QObject *parent = nullptr);
+    ~Session() override;
+
+    void start();
+
+private:
+    void handleLine(const QByteArray &line);
+    void handleRequest(const QJsonObject &request);
+    void resolveProject(const QJsonObject &request);
+    void buildProject(const QJsonObject &request);
+    void cleanProject(const QJsonObject &request);
+    void quitSession();
+    QList<ProductData> productsFromRequest(const QJsonObject &request) const;
+    void startJob(AbstractJob *job);
+    void handleJobFinished(bool success, AbstractJob *job);
+    void handleTaskStarted(const QString &description, int maximumProgressValue);
+    void handleTaskProgress(int newProgressValue);
+    void handleCommandDescription(const QString &highlight, const QString &message);
+    void handleProcessResult(const ProcessResult &result);
+    void sendPacket(const QJsonObject &packet);
+    void sendProtocolError(const QString &message);
+
+    Settings * const m_settings;
+    const std::unique_ptr<SessionLogSink> m_logSink;
+    StdinReader * const m_stdinReader;
+    QFile m_stdout;
+    std::mutex m_stdoutMutex; // Log messages arrive from the threads the jobs run in.
+    Project m_project;
+    AbstractJob *m_currentJob = nullptr;
+    QString m_currentReplyType;
+    bool m_quitRequested = false;
+};
+
+} // namespace qbs
+
+#endif // QBS_SESSION_H
@@ -0,0 +1,151 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "stdinreader.h"
+
+#include <QtCore/qfile.h>
+#include <QtCore/qthread.h>
+
+#ifdef Q_OS_UNIX
+#include <QtCore/qsocketnotifier.h>
+
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+
+namespace qbs {
+
+// Waiting for input on a console or pipe cannot be integrated into the event loop on Windows,
+// so there the lines are read in a thread of their own.
+class StdinReaderThread : public QThread
+{
+    Q_OBJECT
+public:
+    StdinReaderThread() { connect(this, &QThread::finished, this, &QObject::deleteLater); }
+
+signals:
+    void lineRead(const QByteArray &line);
+    void endOfInput();
+
+private:
+    void run() override
+    {
+        QFile input;
+        if (!input.open(stdin, QIODevice::ReadOnly)) {
+            emit endOfInput();
+            return;
+        }
+        while (true) {
+            const QByteArray rawLine = input.readLine();
+            if (rawLine.isEmpty()) // Complete lines contain at least the newline character.
+                break;
+            const QByteArray line = rawLine.trimmed();
+            if (!line.isEmpty())
+                emit lineRead(line);
+        }
+        emit endOfInput();
+    }
+};
+
+StdinReader::StdinReader(QObject *parent) : QObject(parent)
+{
+}
+
+void StdinReader::start()
+{
+#ifdef Q_OS_UNIX
+    m_notifier = new QSocketNotifier(STDIN_FILENO, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &StdinReader::readData);
+#else
+    // The thread is blocked in a read call most of the time, which there is no portable way
+    // to interrupt. It has no parent and deletes itself, so it can outlive this object
+    // without ever having to be terminated.
+    const auto thread = new StdinReaderThread;
+    connect(thread, &StdinReaderThread::lineRead, this, &StdinReader::lineRead);
+    connect(thread, &StdinReaderThread::endOfInput, this, &StdinReader::endOfInput);
+    thread->start();
+#endif
+}
+
+void StdinReader::readData()
+{
+#ifdef Q_OS_UNIX
+    // Only one read per notification, as stdin is shared with other processes and must
+    // therefore not be put into non-blocking mode.
+    char buffer[4096];
+    const ssize_t bytesRead = ::read(STDIN_FILENO, buffer, sizeof buffer);
+    if (bytesRead < 0 && (errno == EINTR || errno == EAGAIN))
+        return;
+    if (bytesRead > 0) {
+        m_data.append(buffer, int(bytesRead));
+        emitLines(false);
+        return;
+    }
+    m_notifier->setEnabled(false);
+    emitLines(true);
+    emit endOfInput();
+#endif
+}
+
+void StdinReader::emitLines(bool atEnd)
+{
+    int lineStart = 0;
+    while (true) {
+        const int lineEnd = m_data.indexOf('\n', lineStart);
+        if (lineEnd == -1)
+            break;
+        const QByteArray line = m_data.mid(lineStart, lineEnd - lineStart).trimmed();
+        lineStart = lineEnd + 1;
+        if (!line.isEmpty())
+            emit lineRead(line);
+    }
+    m_data.remove(0, lineStart);
+    if (atEnd) {
+        const QByteArray line = m_data.trimmed();
+        m_data.clear();
+        if (!line.isEmpty())
+            emit lineRead(line);
+    }
+}
+
+} // namespace qbs
+
+#include "stdinreader.moc"
@@ -323,6 +323,8 @@ void InternalSetupProjectJob::resolveProjectFromScratch(ScriptEngine *engine)
     Loader loader(engine, logger());
     loader.setSearchPaths(m_parameters.searchPaths());
     loader.setProgressObserver(observer());
+    if (m_existingProject)
+        loader.setASTCache(m_existingProject->astCache);
     m_newProject = loader.loadProject(m_parameters);
     QBS_CHECK(m_newProject);
 }
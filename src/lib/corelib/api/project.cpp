@@ -724,8 +724,17 @@ void ProjectPrivate::prepareChangeToProject()
 RuleCommandList ProjectPrivate::ruleCommandListForTransformer(const Transformer *transformer)
 {
     RuleCommandList list;
-    for (const AbstractCommandPtr &internalCommand : qAsConst(transformer->commands.commands())) {
+    const bool hasResourceUsages = int(transformer->commandResourceUsages.size())
+            == transformer->commands.size();
+    for (int i = 0; i < transformer->commands.size(); ++i) {
+        const AbstractCommandPtr &internalCommand = transformer->commands.commandAt(i);
         RuleCommand externalCommand;
+        if (hasResourceUsages) {
+            const CommandResourceUsage &usage = transformer->commandResourceUsages.at(i);
+            externalCommand.d->lastWallTime = usage.wallTime;
+            externalCommand.d->lastCpuTime = usage.cpuTime;
+            externalCommand.d->lastPeakMemoryUsage = usage.peakMemoryUsage;
+        }
         externalCommand.d->description = internalCommand->description();
         externalCommand.d->extendedDescription = internalCommand->extendedDescription();
         switch (internalCommand->type()) {
@@ -1166,6 +1175,54 @@ std::set<QString> Project::buildSystemFiles() const
     return d->internalProject->buildSystemFiles.toStdSet();
 }
 
+/*!
+ * \brief Returns the directories in which the project's wildcard patterns were expanded.
+ * If files are added to or removed from one of these directories, the project needs to be
+ * resolved again.
+ */
+std::set<QString> Project::wildcardDirectories() const
+{
+    QBS_ASSERT(isValid(), return std::set<QString>());
+    std::set<QString> dirPaths;
+    for (const ResolvedProductPtr &product : d->internalProject->allProducts()) {
+        for (const GroupPtr &group : product->groups) {
+            if (!group->wildcards)
+                continue;
+            for (const auto &dirAndTimeStamp : group->wildcards->dirTimeStamps)
+                dirPaths.insert(dirAndTimeStamp.first);
+        }
+    }
+    return dirPaths;
+}
+
+/*!
+ * \brief Returns the files that the dependency scanners found during the last build and that
+ * are not generated by the build.
+ * If one of these files changes, the artifacts depending on it need to be rebuilt.
+ */
+std::set<QString> Project::scannedDependencies() const
+{
+    QBS_ASSERT(isValid(), return std::set<QString>());
+    std::set<QString> filePaths;
+    const TopLevelProject * const project = d->internalProject.get();
+    if (!project->buildData)
+        return filePaths;
+    for (const FileDependency * const dependency : project->buildData->fileDependencies)
+        filePaths.insert(dependency->filePath());
+    for (const ResolvedProductPtr &product : project->allProducts()) {
+        if (!product->buildData)
+            continue;
+        for (const Artifact * const artifact
+             : filterByType<Artifact>(product->buildData->allNodes())) {
+            for (const Artifact * const child : artifact->childrenAddedByScanner) {
+                if (child->artifactType == Artifact::SourceFile)
+                    filePaths.insert(child->filePath());
+            }
+        }
+    }
+    return filePaths;
+}
+
 RuleCommandList Project::ruleCommands(const ProductData &product,
         const QString &inputFilePath, const QString &outputFileTag, ErrorInfo *error) const
 {
@@ -135,6 +135,8 @@ public:
     QVariantMap projectConfiguration() const;
 
     std::set<QString> buildSystemFiles() const;
+    std::set<QString> wildcardDirectories() const;
+    std::set<QString> scannedDependencies() const;
 
     RuleCommandList ruleCommands(const ProductData &product, const QString &inputFilePath,
                                  const QString &outputFileTag, ErrorInfo *error = nullptr) const;
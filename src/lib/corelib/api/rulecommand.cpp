@@ -157,4 +157,37 @@ QProcessEnvironment RuleCommand::environment() const
     return d->environment;
 }
 
+/*!
+ * Returns the number of milliseconds that passed while this command was running
+ * the last time it was executed, or a negative value if that is not known.
+ */
+qint64 RuleCommand::lastWallTime() const
+{
+    return d->lastWallTime;
+}
+
+/*!
+ * Returns the number of milliseconds of CPU time that this command used the last time
+ * it was executed, or a negative value if that is not known.
+ * The value includes the CPU time of all processes started by the command's executable.
+ * It is only available for commands of type \c ProcessCommandType on Linux hosts with
+ * glibc 2.29 or later.
+ */
+qint64 RuleCommand::lastCpuTime() const
+{
+    return d->lastCpuTime;
+}
+
+/*!
+ * Returns the peak resident set size in bytes of the process that was started when this command
+ * was last executed, or a negative value if that is not known.
+ * If the process started other processes, the value is the largest one among all of them.
+ * It is only available for commands of type \c ProcessCommandType on Linux hosts with
+ * glibc 2.29 or later.
+ */
+qint64 RuleCommand::lastPeakMemoryUsage() const
+{
+    return d->lastPeakMemoryUsage;
+}
+
 } // namespace qbs
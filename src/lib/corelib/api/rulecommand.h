@@ -78,6 +78,10 @@ public:
     QString workingDirectory() const;
     QProcessEnvironment environment() const;
 
+    qint64 lastWallTime() const;
+    qint64 lastCpuTime() const;
+    qint64 lastPeakMemoryUsage() const;
+
 private:
     QExplicitlySharedDataPointer<Internal::RuleCommandPrivate> d;
 };
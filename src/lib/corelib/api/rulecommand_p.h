@@ -61,6 +61,9 @@ public:
     QStringList arguments;
     QString workingDir;
     QProcessEnvironment environment;
+    qint64 lastWallTime = -1;
+    qint64 lastCpuTime = -1;
+    qint64 lastPeakMemoryUsage = -1;
 };
 
 } // namespace Internal
@@ -687,6 +687,8 @@ void applyPerArtifactProperties(Artifact *artifact)
         setConfigProperty(props, property.first, property.second);
     artifact->properties = artifact->properties->clone();
     artifact->properties->setValue(props);
+    artifact->properties = artifact->product->topLevelProject()->propertyMapInterner
+            .intern(artifact->properties);
 }
 
 void updateGeneratedArtifacts(ResolvedProduct *product)
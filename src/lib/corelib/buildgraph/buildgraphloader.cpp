@@ -136,6 +136,7 @@ BuildGraphLoadResult BuildGraphLoader::load(const TopLevelProjectPtr &existingPr
         m_wildcardExpansionEffort = 0;
         m_propertyComparisonEffort = 0;
     }
+    m_fileStatCache.clear();
     trackProjectChanges();
     if (m_parameters.logElapsedTime()) {
         m_logger.qbsLog(LoggerInfo, true) << "\t"
@@ -341,6 +342,7 @@ void BuildGraphLoader::trackProjectChanges()
     ldr.setProgressObserver(m_evalContext->observer());
     ldr.setOldProjectProbes(restoredProject->probes);
     ldr.setLastResolveTime(restoredProject->lastResolveTime);
+    ldr.setASTCache(restoredProject->astCache);
     QHash<QString, std::vector<ProbeConstPtr>> restoredProbes;
     for (const auto &restoredProduct : qAsConst(allRestoredProducts))
         restoredProbes.insert(restoredProduct->uniqueName(), restoredProduct->probes);
@@ -524,7 +526,7 @@ bool BuildGraphLoader::hasFileExistsResultChanged(const TopLevelProjectConstPtr
 {
     for (QHash<QString, bool>::ConstIterator it = restoredProject->fileExistsResults.constBegin();
          it != restoredProject->fileExistsResults.constEnd(); ++it) {
-        if (FileInfo(it.key()).exists() != it.value()) {
+        if (m_fileStatCache.exists(it.key()) != it.value()) {
             qCDebug(lcBuildGraph) << "Existence check for file" << it.key()
                                   << "changed, must re-resolve project.";
             return true;
@@ -555,7 +557,7 @@ bool BuildGraphLoader::hasFileLastModifiedResultChanged(const TopLevelProjectCon
     for (QHash<QString, FileTime>::ConstIterator it
          = restoredProject->fileLastModifiedResults.constBegin();
          it != restoredProject->fileLastModifiedResults.constEnd(); ++it) {
-        if (FileInfo(it.key()).lastModified() != it.value()) {
+        if (m_fileStatCache.lastModified(it.key()) != it.value()) {
             qCDebug(lcBuildGraph) << "Timestamp for file" << it.key()
                                   << "changed, must re-resolve project.";
             return true;
@@ -572,7 +574,7 @@ bool BuildGraphLoader::hasProductFileChanged(const std::vector<ResolvedProductPt
     bool hasChanged = false;
     for (const ResolvedProductPtr &product : restoredProducts) {
         const QString filePath = product->location.filePath();
-        const FileInfo pfi(filePath);
+        const FileInfo pfi = m_fileStatCache.fileInfo(filePath);
         remainingBuildSystemFiles.remove(filePath);
         if (!pfi.exists()) {
             qCDebug(lcBuildGraph) << "A product was removed, must re-resolve project";
@@ -583,7 +585,7 @@ bool BuildGraphLoader::hasProductFileChanged(const std::vector<ResolvedProductPt
         } else if (!contains(changedProducts, product)) {
             bool foundMissingSourceFile = false;
             for (const QString &file : qAsConst(product->missingSourceFiles)) {
-                if (FileInfo(file).exists()) {
+                if (m_fileStatCache.exists(file)) {
                     qCDebug(lcBuildGraph) << "Formerly missing file" << file << "in product"
                                           << product->name << "exists now, must re-resolve project";
                     foundMissingSourceFile = true;
@@ -604,8 +606,8 @@ bool BuildGraphLoader::hasProductFileChanged(const std::vector<ResolvedProductPt
                 const bool reExpansionRequired = std::any_of(
                             group->wildcards->dirTimeStamps.cbegin(),
                             group->wildcards->dirTimeStamps.cend(),
-                            [](const std::pair<QString, FileTime> &pair) {
-                                return FileInfo(pair.first).lastModified() > pair.second;
+                            [this](const std::pair<QString, FileTime> &pair) {
+                                return m_fileStatCache.lastModified(pair.first) > pair.second;
                 });
                 if (!reExpansionRequired)
                     continue;
@@ -615,8 +617,12 @@ bool BuildGraphLoader::hasProductFileChanged(const std::vector<ResolvedProductPt
                 Set<QString> wcFiles;
                 for (const SourceArtifactConstPtr &sourceArtifact : group->wildcards->files)
                     wcFiles += sourceArtifact->absoluteFilePath;
-                if (files == wcFiles)
+                if (files == wcFiles) {
+                    // Store the updated directory listings, so the next check does not
+                    // have to read the changed directories again.
+                    product->topLevelProject()->buildData->setDirty();
                     continue;
+                }
                 hasChanged = true;
                 changedProducts.push_back(product);
                 break;
@@ -631,7 +637,7 @@ bool BuildGraphLoader::hasBuildSystemFileChanged(const Set<QString> &buildSystem
                                                  const FileTime &referenceTime)
 {
     for (const QString &file : buildSystemFiles) {
-        const FileInfo fi(file);
+        const FileInfo fi = m_fileStatCache.fileInfo(file);
         if (!fi.exists() || referenceTime < fi.lastModified()) {
             qCDebug(lcBuildGraph) << "A qbs or js file changed, must re-resolve project.";
             return true;
@@ -941,6 +947,8 @@ void BuildGraphLoader::rescueOldBuildData(const ResolvedProductConstPtr &restore
             rad.lastCommandExecutionTime = oldArtifact->transformer->lastCommandExecutionTime;
             rad.lastPrepareScriptExecutionTime
                     = oldArtifact->transformer->lastPrepareScriptExecutionTime;
+            rad.commandResourceUsages = oldArtifact->transformer->commandResourceUsages;
+            rad.inputContentHashes = oldArtifact->transformer->inputContentHashes;
             const ChildrenInfo &childrenInfo = childLists.value(oldArtifact);
             for (Artifact * const child : qAsConst(childrenInfo.children)) {
                 rad.children.emplace_back(child->product->name,
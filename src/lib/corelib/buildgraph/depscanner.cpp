@@ -68,21 +68,27 @@ QString DependencyScanner::id() const
     return m_id;
 }
 
-static QStringList collectCppIncludePaths(const QVariantMap &modules)
+static QStringList collectCppIncludePaths(const PropertyMapInternal &properties)
 {
-    QStringList result;
-    const QVariantMap cpp = modules.value(StringConstants::cppModule()).toMap();
-    if (cpp.empty())
-        return result;
+    static const ModulePropertyPath includePaths(StringConstants::cppModule(),
+                                                 QStringLiteral("includePaths"));
+    static const ModulePropertyPath treatSystemHeadersAsDependencies(
+                StringConstants::cppModule(), QStringLiteral("treatSystemHeadersAsDependencies"));
+    static const ModulePropertyPath systemIncludePaths(StringConstants::cppModule(),
+                                                       QStringLiteral("systemIncludePaths"));
+    static const ModulePropertyPath distributionIncludePaths(
+                StringConstants::cppModule(), QStringLiteral("distributionIncludePaths"));
+    static const ModulePropertyPath compilerIncludePaths(StringConstants::cppModule(),
+                                                         QStringLiteral("compilerIncludePaths"));
 
-    result << cpp.value(QStringLiteral("includePaths")).toStringList();
+    QStringList result = properties.moduleProperty(includePaths).toStringList();
     const bool useSystemHeaders
-            = cpp.value(QStringLiteral("treatSystemHeadersAsDependencies")).toBool();
+            = properties.moduleProperty(treatSystemHeadersAsDependencies).toBool();
     if (useSystemHeaders) {
         result
-            << cpp.value(QStringLiteral("systemIncludePaths")).toStringList()
-            << cpp.value(QStringLiteral("distributionIncludePaths")).toStringList()
-            << cpp.value(QStringLiteral("compilerIncludePaths")).toStringList();
+            << properties.moduleProperty(systemIncludePaths).toStringList()
+            << properties.moduleProperty(distributionIncludePaths).toStringList()
+            << properties.moduleProperty(compilerIncludePaths).toStringList();
     }
     result.removeDuplicates();
     return result;
@@ -96,7 +102,7 @@ PluginDependencyScanner::PluginDependencyScanner(ScannerPlugin *plugin)
 QStringList PluginDependencyScanner::collectSearchPaths(Artifact *artifact)
 {
     if (m_plugin->flags & ScannerUsesCppIncludePaths)
-        return collectCppIncludePaths(artifact->properties->value());
+        return collectCppIncludePaths(*artifact->properties);
     return QStringList();
 }
 
@@ -134,6 +140,16 @@ bool PluginDependencyScanner::recursive() const
     return m_plugin->flags & ScannerRecursiveDependencies;
 }
 
+bool PluginDependencyScanner::isThreadSafe() const
+{
+    return m_plugin->flags & ScannerThreadSafe;
+}
+
+bool PluginDependencyScanner::isCppIncludeScanner() const
+{
+    return m_plugin->flags & ScannerUsesCppIncludePaths;
+}
+
 const void *PluginDependencyScanner::key() const
 {
     return m_plugin;
@@ -184,6 +200,16 @@ bool UserDependencyScanner::recursive() const
     return m_scanner->recursive;
 }
 
+bool UserDependencyScanner::isThreadSafe() const
+{
+    return false; // Needs the script engine.
+}
+
+bool UserDependencyScanner::isCppIncludeScanner() const
+{
+    return false;
+}
+
 const void *UserDependencyScanner::key() const
 {
     return m_scanner.get();
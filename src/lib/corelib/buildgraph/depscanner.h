@@ -68,6 +68,8 @@ public:
     virtual QStringList collectSearchPaths(Artifact *artifact) = 0;
     virtual QStringList collectDependencies(FileResourceBase *file, const char *fileTags) = 0;
     virtual bool recursive() const = 0;
+    virtual bool isThreadSafe() const = 0;
+    virtual bool isCppIncludeScanner() const = 0;
     virtual const void *key() const = 0;
     virtual bool areModulePropertiesCompatible(const PropertyMapConstPtr &m1,
                                                const PropertyMapConstPtr &m2) const = 0;
@@ -87,6 +89,8 @@ private:
     QStringList collectSearchPaths(Artifact *artifact) override;
     QStringList collectDependencies(FileResourceBase *file, const char *fileTags) override;
     bool recursive() const override;
+    bool isThreadSafe() const override;
+    bool isCppIncludeScanner() const override;
     const void *key() const override;
     QString createId() const override;
     bool areModulePropertiesCompatible(const PropertyMapConstPtr &m1,
@@ -104,6 +108,8 @@ private:
     QStringList collectSearchPaths(Artifact *artifact) override;
     QStringList collectDependencies(FileResourceBase *file, const char *fileTags) override;
     bool recursive() const override;
+    bool isThreadSafe() const override;
+    bool isCppIncludeScanner() const override;
     const void *key() const override;
     QString createId() const override;
     bool areModulePropertiesCompatible(const PropertyMapConstPtr &m1,
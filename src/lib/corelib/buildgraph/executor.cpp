@@ -75,6 +75,7 @@
 #include <algorithm>
 #include <climits>
 #include <iterator>
+#include <unordered_set>
 #include <utility>
 
 namespace qbs {
@@ -82,6 +83,18 @@ namespace Internal {
 
 bool Executor::ComparePriority::operator() (const BuildGraphNode *x, const BuildGraphNode *y) const
 {
+    if (executor && executor->m_buildOptions.criticalPathScheduling()) {
+        // Applying a rule does not occupy a job and reveals the commands to be run,
+        // so rule nodes always come first.
+        const bool xIsRuleNode = x->type() == BuildGraphNode::RuleNodeType;
+        const bool yIsRuleNode = y->type() == BuildGraphNode::RuleNodeType;
+        if (xIsRuleNode != yIsRuleNode)
+            return yIsRuleNode;
+        const qint64 xCost = executor->remainingPathCost(x);
+        const qint64 yCost = executor->remainingPathCost(y);
+        if (xCost != yCost)
+            return xCost < yCost;
+    }
     return x->product->buildData->buildPriority() < y->product->buildData->buildPriority();
 }
 
@@ -94,7 +107,7 @@ Executor::Executor(const Logger &logger, QObject *parent)
     , m_state(ExecutorIdle)
     , m_cancelationTimer(new QTimer(this))
 {
-    m_inputArtifactScanContext = new InputArtifactScannerContext;
+    m_inputArtifactScanContext = new InputArtifactScannerContext(&m_fileStatCache);
     m_cancelationTimer->setSingleShot(false);
     m_cancelationTimer->setInterval(1000);
     connect(m_cancelationTimer, &QTimer::timeout, this, &Executor::checkForCancellation);
@@ -114,7 +127,7 @@ Executor::~Executor()
 FileTime Executor::recursiveFileTime(const QString &filePath) const
 {
     FileTime newest;
-    FileInfo fileInfo(filePath);
+    const FileInfo fileInfo = m_fileStatCache.fileInfo(filePath);
     if (!fileInfo.exists()) {
         const QString nativeFilePath = QDir::toNativeSeparators(filePath);
         m_logger.qbsWarning() << Tr::tr("File '%1' not found.").arg(nativeFilePath);
@@ -224,7 +237,7 @@ void Executor::doBuild()
                         << m_buildOptions.maxJobCount();
     }
     QBS_CHECK(m_state == ExecutorIdle);
-    m_leaves = Leaves();
+    m_leaves = Leaves(ComparePriority(this));
     m_error.clear();
     m_explicitlyCanceled = false;
     m_activeFileTags = FileTags::fromStringList(m_buildOptions.activeFileTags());
@@ -232,7 +245,7 @@ void Executor::doBuild()
     m_tagsNeededForFilesToConsider.clear();
     m_productsOfFilesToConsider.clear();
     m_artifactsRemovedFromDisk.clear();
-    m_jobCountPerPool.clear();
+    m_jobPoolStates.clear();
 
     setupJobLimits();
 
@@ -284,13 +297,18 @@ void Executor::doBuild()
         m_productInstaller->removeInstallRoot();
 
     addExecutorJobs();
+    prefetchFileStats();
     syncFileDependencies();
     prepareAllNodes();
     prepareProducts();
     setupRootNodes();
     prepareReachableNodes();
+    setupCriticalPathScheduling();
     setupProgressObserver();
     initLeaves();
+
+    // Commands can write files that are not declared as outputs, e.g. into source directories.
+    m_fileStatCache.stopCachingMisses();
     if (!scheduleJobs()) {
         qCDebug(lcExec) << "Nothing to do at all, finishing.";
         QTimer::singleShot(0, this, &Executor::finish); // Don't call back on the caller.
@@ -397,36 +415,40 @@ bool Executor::schedulingBlockedByJobLimit(const BuildGraphNode *node)
         return false;
 
     const Transformer * const transformer = artifact->transformer.get();
+    const JobLimits &jobLimits = m_jobLimitsPerProduct.at(transformer->product().get());
     for (const QString &jobPool : transformer->jobPools()) {
-        const int currentJobCount = m_jobCountPerPool[jobPool];
-        if (currentJobCount == 0)
+        const auto stateIt = m_jobPoolStates.find(jobPool);
+        if (stateIt == m_jobPoolStates.cend() || stateIt->second.jobCount == 0)
             continue;
-        const auto jobLimitIsExceeded = [currentJobCount, jobPool, this](const Transformer *t) {
-            const int maxJobCount = m_jobLimitsPerProduct.at(t->product().get())
-                    .getLimit(jobPool);
-            return maxJobCount > 0 && currentJobCount >= maxJobCount;
-        };
+        const JobPoolState &state = stateIt->second;
 
         // Different products can set different limits. The effective limit is the minimum of what
         // is set in this transformer's product and in the products of all currently
         // running transformers.
-        if (jobLimitIsExceeded(transformer))
-            return true;
-        for (const ExecutorJob * const runningJob : m_processingJobs.keys()) {
-            if (!runningJob->jobPools().contains(jobPool))
-                continue;
-            const Transformer * const runningTransformer = runningJob->transformer();
-            if (!runningTransformer)
-                continue; // This can happen if the ExecutorJob has already finished.
-            if (runningTransformer->product() == transformer->product())
-                continue; // We have already checked this product's job limit.
-            if (jobLimitIsExceeded(runningTransformer))
-                return true;
+        int maxJobCount = jobLimits.getLimit(jobPool);
+        if (!state.activeLimits.empty()) {
+            const int minActiveLimit = state.activeLimits.cbegin()->first;
+            if (maxJobCount <= 0 || minActiveLimit < maxJobCount)
+                maxJobCount = minActiveLimit;
         }
+        if (maxJobCount > 0 && state.jobCount >= maxJobCount)
+            return true;
     }
     return false;
 }
 
+// Checks whether the file has the same contents as when the transformer's commands last ran.
+static bool hasUnchangedContent(const Transformer *transformer, FileResourceBase *file)
+{
+    const auto it = transformer->inputContentHashes.find(file->filePath());
+    if (it == transformer->inputContentHashes.cend())
+        return false;
+    const bool unchanged = file->contentHash() == it->second;
+    qCDebug(lcUpToDateCheck) << "content of" << file->filePath()
+                             << (unchanged ? "unchanged" : "changed");
+    return unchanged;
+}
+
 bool Executor::isUpToDate(Artifact *artifact) const
 {
     QBS_CHECK(artifact->artifactType == Artifact::Generated);
@@ -435,7 +457,7 @@ bool Executor::isUpToDate(Artifact *artifact) const
                              << artifact->timestamp().toString();
 
     if (m_buildOptions.forceTimestampCheck()) {
-        artifact->setTimestamp(FileInfo(artifact->filePath()).lastModified());
+        artifact->setTimestamp(m_fileStatCache.lastModified(artifact->filePath()));
         qCDebug(lcUpToDateCheck) << "timestamp retrieved from filesystem:"
                                  << artifact->timestamp().toString();
     }
@@ -450,8 +472,11 @@ bool Executor::isUpToDate(Artifact *artifact) const
         qCDebug(lcUpToDateCheck) << "child timestamp"
                                  << childArtifact->timestamp().toString()
                                  << childArtifact->filePath();
-        if (artifact->timestamp() < childArtifact->timestamp())
+        if (artifact->timestamp() < childArtifact->timestamp()
+                && !(m_buildOptions.contentHashCheck()
+                     && hasUnchangedContent(artifact->transformer.get(), childArtifact))) {
             return false;
+        }
     }
 
     for (FileDependency *fileDependency : qAsConst(artifact->fileDependencies)) {
@@ -463,8 +488,11 @@ bool Executor::isUpToDate(Artifact *artifact) const
         qCDebug(lcUpToDateCheck) << "file dependency timestamp"
                                  << fileDependency->timestamp().toString()
                                  << fileDependency->filePath();
-        if (artifact->timestamp() < fileDependency->timestamp())
+        if (artifact->timestamp() < fileDependency->timestamp()
+                && !(m_buildOptions.contentHashCheck()
+                     && hasUnchangedContent(artifact->transformer.get(), fileDependency))) {
             return false;
+        }
     }
 
     return true;
@@ -543,6 +571,8 @@ void Executor::executeRuleNode(RuleNode *ruleNode)
     updateLeaves(result.createdArtifacts);
     updateLeaves(result.invalidatedArtifacts);
     m_artifactsRemovedFromDisk << result.removedArtifacts;
+    for (const QString &filePath : qAsConst(result.removedArtifacts))
+        m_fileStatCache.invalidate(filePath);
 
     if (m_progressObserver) {
         const int transformerCount = ruleNode->transformerCount();
@@ -570,13 +600,21 @@ void Executor::finishJob(ExecutorJob *job, bool success)
     updateJobCounts(transformer.get(), -1);
     if (success) {
         m_project->buildData->setDirty();
+        const bool checkContentHashes = m_buildOptions.contentHashCheck()
+                && !m_buildOptions.dryRun();
         for (Artifact * const artifact : qAsConst(transformer->outputs)) {
+            m_fileStatCache.invalidate(artifact->filePath());
             if (artifact->alwaysUpdated) {
                 artifact->setTimestamp(FileTime::currentTime());
-                for (Artifact * const parent : artifact->parentArtifacts())
-                    parent->transformer->markedForRerun = true;
+                for (Artifact * const parent : artifact->parentArtifacts()) {
+                    if (!checkContentHashes
+                            || !hasUnchangedContent(parent->transformer.get(), artifact)) {
+                        parent->transformer->markedForRerun = true;
+                    }
+                }
                 if (m_buildOptions.forceOutputCheck()
-                        && !m_buildOptions.dryRun() && !FileInfo(artifact->filePath()).exists()) {
+                        && !m_buildOptions.dryRun()
+                        && !m_fileStatCache.exists(artifact->filePath())) {
                     if (transformer->rule) {
                         if (!transformer->rule->name.isEmpty()) {
                             throw ErrorInfo(tr("Rule '%1' declares artifact '%2', "
@@ -592,9 +630,14 @@ void Executor::finishJob(ExecutorJob *job, bool success)
                                     .arg(artifact->filePath()));
                 }
             } else {
-                artifact->setTimestamp(FileInfo(artifact->filePath()).lastModified());
+                artifact->setTimestamp(m_fileStatCache.lastModified(artifact->filePath()));
             }
         }
+        readDependencyFiles(transformer);
+        if (checkContentHashes)
+            recordInputContentHashes(transformer);
+        else if (!m_buildOptions.dryRun())
+            transformer->inputContentHashes.clear();
         finishTransformer(transformer);
     }
 
@@ -695,6 +738,64 @@ bool Executor::transformerHasMatchingInputFiles(const TransformerConstPtr &trans
     return false;
 }
 
+void Executor::setupCriticalPathScheduling()
+{
+    m_remainingPathCosts.clear();
+    m_defaultTransformerDuration = 0;
+    if (!m_buildOptions.criticalPathScheduling())
+        return;
+
+    // Commands that have not run before are assumed to take as long as an average one.
+    Set<const Transformer *> seenTransformers;
+    qint64 totalDuration = 0;
+    qint64 transformerCount = 0;
+    for (const ResolvedProductPtr &product : m_productsToBuild) {
+        for (const Artifact * const artifact
+             : filterByType<Artifact>(product->buildData->allNodes())) {
+            const Transformer * const transformer = artifact->transformer.get();
+            if (!transformer || !seenTransformers.insert(transformer).second)
+                continue;
+            const qint64 duration = transformer->lastExecutionDuration();
+            if (duration < 0)
+                continue;
+            totalDuration += duration;
+            ++transformerCount;
+        }
+    }
+    if (transformerCount > 0)
+        m_defaultTransformerDuration = totalDuration / transformerCount;
+}
+
+qint64 Executor::estimatedDuration(const BuildGraphNode *node) const
+{
+    if (node->type() != BuildGraphNode::ArtifactNodeType)
+        return 0;
+    const auto artifact = static_cast<const Artifact *>(node);
+    if (artifact->artifactType != Artifact::Generated || !artifact->transformer)
+        return 0;
+    const qint64 duration = artifact->transformer->lastExecutionDuration();
+    return duration >= 0 ? duration : m_defaultTransformerDuration;
+}
+
+// The estimated time it takes to get from the start of this node to the end of the build,
+// that is, the cost of the most expensive chain of nodes from this node up to a root node.
+// The value is computed only once per node, as the priority queue relies on stable priorities.
+qint64 Executor::remainingPathCost(const BuildGraphNode *node)
+{
+    const auto it = m_remainingPathCosts.find(node);
+    if (it != m_remainingPathCosts.cend())
+        return it->second;
+    qint64 maxParentCost = 0;
+    for (const BuildGraphNode * const parent : node->parents) {
+        if (parent->buildState == BuildGraphNode::Untouched)
+            continue; // Not part of this build.
+        maxParentCost = std::max(maxParentCost, remainingPathCost(parent));
+    }
+    const qint64 cost = estimatedDuration(node) + maxParentCost;
+    m_remainingPathCosts.insert(std::make_pair(node, cost));
+    return cost;
+}
+
 void Executor::setupJobLimits()
 {
     Settings settings(m_buildOptions.settingsDirectory());
@@ -715,8 +816,18 @@ void Executor::setupJobLimits()
 
 void Executor::updateJobCounts(const Transformer *transformer, int diff)
 {
-    for (const QString &jobPool : transformer->jobPools())
-        m_jobCountPerPool[jobPool] += diff;
+    const JobLimits &jobLimits = m_jobLimitsPerProduct.at(transformer->product().get());
+    for (const QString &jobPool : transformer->jobPools()) {
+        JobPoolState &state = m_jobPoolStates[jobPool];
+        state.jobCount += diff;
+        const int limit = jobLimits.getLimit(jobPool);
+        if (limit <= 0)
+            continue;
+        const auto limitIt = state.activeLimits.insert(std::make_pair(limit, 0)).first;
+        limitIt->second += diff;
+        if (limitIt->second == 0)
+            state.activeLimits.erase(limitIt);
+    }
 }
 
 void Executor::cancelJobs()
@@ -820,6 +931,7 @@ void Executor::rescueOldBuildData(Artifact *artifact, bool *childrenAdded = null
                 if (childRad.isValid()) {
                     m_artifactsRemovedFromDisk << artifact->filePath();
                     removeGeneratedArtifactFromDisk(cd.childFilePath, m_logger);
+                    m_fileStatCache.invalidate(cd.childFilePath);
                 }
             }
             if (!cd.addedByScanner) {
@@ -891,6 +1003,8 @@ void Executor::rescueOldBuildData(Artifact *artifact, bool *childrenAdded = null
                 = rad.exportedModulesAccessedInCommands;
         artifact->transformer->lastCommandExecutionTime = rad.lastCommandExecutionTime;
         artifact->transformer->lastPrepareScriptExecutionTime = rad.lastPrepareScriptExecutionTime;
+        artifact->transformer->commandResourceUsages = rad.commandResourceUsages;
+        artifact->transformer->inputContentHashes = rad.inputContentHashes;
         artifact->transformer->commandsNeedChangeTracking = true;
         artifact->setTimestamp(rad.timeStamp);
         artifact->transformer->markedForRerun
@@ -904,6 +1018,7 @@ void Executor::rescueOldBuildData(Artifact *artifact, bool *childrenAdded = null
         qCDebug(lcBuildGraph) << "Data was rescued.";
     } else {
         removeGeneratedArtifactFromDisk(artifact, m_logger);
+        m_fileStatCache.invalidate(artifact->filePath());
         m_artifactsRemovedFromDisk << artifact->filePath();
         qCDebug(lcBuildGraph) << "Data not rescued.";
     }
@@ -992,6 +1107,39 @@ void Executor::potentiallyRunTransformer(const TransformerPtr &transformer)
         runTransformer(transformer);
 }
 
+// The dependency file written by a command supersedes what was known before the command ran.
+void Executor::readDependencyFiles(const TransformerPtr &transformer)
+{
+    if (m_buildOptions.dryRun() || !InputArtifactScanner::dependencyFileCommand(transformer.get()))
+        return;
+    for (Artifact * const output : qAsConst(transformer->outputs)) {
+        output->inputsScanned = false;
+        InputArtifactScanner scanner(output, m_inputArtifactScanContext, m_logger);
+        AccumulatingTimer scanTimer(m_buildOptions.logElapsedTime()
+                                    ? &m_elapsedTimeScanners : nullptr);
+        scanner.scan();
+    }
+}
+
+// A file that was changed after the commands had started may not have the content they read,
+// so no digest is recorded for it. Its timestamp then decides, as without the option.
+void Executor::recordInputContentHashes(const TransformerPtr &transformer)
+{
+    transformer->inputContentHashes.clear();
+    const FileTime &commandStartTime = transformer->lastCommandExecutionTime;
+    const auto recordHash = [&transformer, &commandStartTime](FileResourceBase *file) {
+        const QByteArray &hash = file->contentHash();
+        if (!hash.isEmpty() && file->contentHashTimestamp() < commandStartTime)
+            transformer->inputContentHashes[file->filePath()] = hash;
+    };
+    for (Artifact * const output : qAsConst(transformer->outputs)) {
+        for (Artifact * const child : filterByType<Artifact>(output->children))
+            recordHash(child);
+        for (FileDependency * const fileDependency : qAsConst(output->fileDependencies))
+            recordHash(fileDependency);
+    }
+}
+
 void Executor::runTransformer(const TransformerPtr &transformer)
 {
     QBS_CHECK(transformer);
@@ -1095,6 +1243,7 @@ void Executor::checkForUnbuiltProducts()
             const AllRescuableArtifactData rad = product->buildData->rescuableArtifactData();
             for (auto it = rad.cbegin(); it != rad.cend(); ++it) {
                 removeGeneratedArtifactFromDisk(it.key(), m_logger);
+                m_fileStatCache.invalidate(it.key());
                 product->buildData->removeFromRescuableArtifactData(it.key());
                 m_artifactsRemovedFromDisk << it.key();
             }
@@ -1209,12 +1358,40 @@ void Executor::prepareAllNodes()
     }
 }
 
+/**
+  * Reads the directories of the files whose timestamps are about to be checked in one go,
+  * instead of calling stat() for one file at a time.
+  * If only some files are known to have changed, the source files are not looked at.
+  */
+void Executor::prefetchFileStats()
+{
+    m_fileStatCache.clear();
+    std::unordered_set<QString> dirPaths;
+    for (const FileDependency * const dep : qAsConst(m_project->buildData->fileDependencies))
+        dirPaths.insert(FileInfo::path(dep->filePath()));
+    const bool checkSourceFiles = m_buildOptions.changedFiles().empty();
+    const bool checkGeneratedFiles = m_buildOptions.forceTimestampCheck();
+    if (checkSourceFiles || checkGeneratedFiles) {
+        for (const ResolvedProductPtr &product : m_productsToBuild) {
+            QBS_CHECK(product->buildData);
+            for (const Artifact * const artifact
+                 : filterByType<Artifact>(product->buildData->allNodes())) {
+                if (artifact->artifactType == Artifact::SourceFile
+                        ? checkSourceFiles : checkGeneratedFiles) {
+                    dirPaths.insert(FileInfo::path(artifact->filePath()));
+                }
+            }
+        }
+    }
+    m_fileStatCache.prefetchDirectories(dirPaths);
+}
+
 void Executor::syncFileDependencies()
 {
     Set<FileDependency *> &globalFileDepList = m_project->buildData->fileDependencies;
     for (auto it = globalFileDepList.begin(); it != globalFileDepList.end(); ) {
         FileDependency * const dep = *it;
-        FileInfo fi(dep->filePath());
+        const FileInfo fi = m_fileStatCache.fileInfo(dep->filePath());
         if (fi.exists()) {
             dep->setTimestamp(fi.lastModified());
             ++it;
@@ -48,10 +48,12 @@
 #include <logging/logger.h>
 #include <tools/buildoptions.h>
 #include <tools/error.h>
+#include <tools/filestatcache.h>
 #include <tools/qttools.h>
 
 #include <QtCore/qobject.h>
 
+#include <map>
 #include <queue>
 #include <unordered_map>
 
@@ -106,13 +108,17 @@ private:
 
     struct ComparePriority
     {
+        ComparePriority(Executor *executor = nullptr) : executor(executor) {}
         bool operator() (const BuildGraphNode *x, const BuildGraphNode *y) const;
+
+        Executor *executor;
     };
 
     typedef std::priority_queue<BuildGraphNode *, std::vector<BuildGraphNode *>,
                                 ComparePriority> Leaves;
 
     void doBuild();
+    void prefetchFileStats();
     void prepareAllNodes();
     void syncFileDependencies();
     void prepareArtifact(Artifact *artifact);
@@ -140,6 +146,8 @@ private:
     bool checkForUnbuiltDependencies(Artifact *artifact);
     void potentiallyRunTransformer(const TransformerPtr &transformer);
     void runTransformer(const TransformerPtr &transformer);
+    void readDependencyFiles(const TransformerPtr &transformer);
+    void recordInputContentHashes(const TransformerPtr &transformer);
     void finishTransformer(const TransformerPtr &transformer);
     void possiblyInstallArtifact(const Artifact *artifact);
     void checkForUnbuiltProducts();
@@ -154,6 +162,10 @@ private:
     bool artifactHasMatchingOutputTags(const Artifact *artifact) const;
     bool transformerHasMatchingInputFiles(const TransformerConstPtr &transformer) const;
 
+    void setupCriticalPathScheduling();
+    qint64 estimatedDuration(const BuildGraphNode *node) const;
+    qint64 remainingPathCost(const BuildGraphNode *node);
+
     void setupJobLimits();
     void updateJobCounts(const Transformer *transformer, int diff);
     bool schedulingBlockedByJobLimit(const BuildGraphNode *node);
@@ -173,12 +185,23 @@ private:
     std::vector<ResolvedProductPtr> m_allProducts;
     std::unordered_map<QString, const ResolvedProduct *> m_productsByName;
     std::unordered_map<QString, const ResolvedProject *> m_projectsByName;
-    std::unordered_map<QString, int> m_jobCountPerPool;
+    struct JobPoolState
+    {
+        int jobCount = 0;
+
+        // Maps the job limits of the products of the running transformers to the number
+        // of such transformers, so the effective limit is always the first key.
+        std::map<int, int> activeLimits;
+    };
+    std::unordered_map<QString, JobPoolState> m_jobPoolStates;
     std::unordered_map<const ResolvedProduct *, JobLimits> m_jobLimitsPerProduct;
     std::unordered_map<const Rule *, int> m_pendingTransformersPerRule;
+    std::unordered_map<const BuildGraphNode *, qint64> m_remainingPathCosts;
+    qint64 m_defaultTransformerDuration = 0;
     NodeSet m_roots;
     Leaves m_leaves;
     InputArtifactScannerContext *m_inputArtifactScanContext;
+    mutable FileStatCache m_fileStatCache;
     ErrorInfo m_error;
     bool m_explicitlyCanceled;
     FileTags m_activeFileTags;
@@ -83,6 +83,7 @@ void ExecutorJob::setMainThreadScriptEngine(ScriptEngine *engine)
 
 void ExecutorJob::setDryRun(bool enabled)
 {
+    m_dryRun = enabled;
     m_processCommandExecutor->setDryRunEnabled(enabled);
     m_jsCommandExecutor->setDryRunEnabled(enabled);
 }
@@ -113,7 +114,6 @@ void ExecutorJob::run(Transformer *t)
     m_processCommandExecutor->setProcessEnvironment(
                 (*t->outputs.cbegin())->product->buildEnvironment);
     m_transformer = t;
-    m_jobPools = t->jobPools();
     runNextCommand();
 }
 
@@ -146,6 +146,7 @@ void ExecutorJob::runNextCommand()
         qFatal("Missing implementation for command type %d", command->type());
     }
 
+    m_commandTimer.start();
     m_currentCommandExecutor->start(m_transformer, command.get());
 }
 
@@ -158,12 +159,22 @@ void ExecutorJob::onCommandFinished(const ErrorInfo &err)
         m_error = err;
         setFinished();
     } else {
+        CommandResourceUsage usage;
+        usage.wallTime = m_commandTimer.elapsed();
+        if (m_currentCommandExecutor == m_processCommandExecutor) {
+            usage.cpuTime = m_processCommandExecutor->cpuTime();
+            usage.peakMemoryUsage = m_processCommandExecutor->peakMemoryUsage();
+        }
+        m_commandResourceUsages.push_back(usage);
         runNextCommand();
     }
 }
 
 void ExecutorJob::setFinished()
 {
+    if (m_transformer && !m_error.hasError() && !m_dryRun) {
+        m_transformer->commandResourceUsages = std::move(m_commandResourceUsages);
+    }
     const ErrorInfo err = m_error;
     reset();
     emit finished(err);
@@ -172,9 +183,9 @@ void ExecutorJob::setFinished()
 void ExecutorJob::reset()
 {
     m_transformer = nullptr;
-    m_jobPools.clear();
     m_currentCommandExecutor = nullptr;
     m_currentCommandIdx = -1;
+    m_commandResourceUsages.clear();
     m_error.clear();
 }
 
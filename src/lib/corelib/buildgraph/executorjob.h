@@ -40,14 +40,18 @@
 #ifndef QBS_EXECUTORJOB_H
 #define QBS_EXECUTORJOB_H
 
+#include "rulecommands.h"
+
 #include <language/forward_decls.h>
 #include <tools/commandechomode.h>
 #include <tools/error.h>
-#include <tools/set.h>
 
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qstring.h>
 
+#include <vector>
+
 namespace qbs {
 class CodeLocation;
 class ProcessResult;
@@ -74,7 +78,6 @@ public:
     void run(Transformer *t);
     void cancel();
     const Transformer *transformer() const { return m_transformer; }
-    Set<QString> jobPools() const { return m_jobPools; }
 
 signals:
     void reportCommandDescription(const QString &highlight, const QString &message);
@@ -92,9 +95,11 @@ private:
     ProcessCommandExecutor *m_processCommandExecutor;
     JsCommandExecutor *m_jsCommandExecutor;
     Transformer *m_transformer;
-    Set<QString> m_jobPools;
     int m_currentCommandIdx;
     ErrorInfo m_error;
+    QElapsedTimer m_commandTimer;
+    std::vector<CommandResourceUsage> m_commandResourceUsages;
+    bool m_dryRun = false;
 };
 
 } // namespace Internal
@@ -41,6 +41,9 @@
 
 #include <tools/fileinfo.h>
 
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qfile.h>
+
 namespace qbs {
 namespace Internal {
 
@@ -63,6 +66,26 @@ const FileTime &FileResourceBase::timestamp() const
     return m_timestamp;
 }
 
+// The file is looked at again rather than trusting timestamp(), as it may have changed since
+// then, e.g. while a command was running. If it changes while being read, there is no digest.
+const QByteArray &FileResourceBase::contentHash()
+{
+    const FileTime currentTimestamp = FileInfo(m_filePath).lastModified();
+    if (!currentTimestamp.isValid()) {
+        m_contentHash.clear();
+    } else if (m_contentHashTimestamp != currentTimestamp || m_contentHash.isEmpty()) {
+        m_contentHash.clear();
+        QFile file(m_filePath);
+        if (file.open(QIODevice::ReadOnly)) {
+            QCryptographicHash hash(QCryptographicHash::Sha1);
+            if (hash.addData(&file) && FileInfo(m_filePath).lastModified() == currentTimestamp)
+                m_contentHash = hash.result();
+        }
+    }
+    m_contentHashTimestamp = m_contentHash.isEmpty() ? FileTime() : currentTimestamp;
+    return m_contentHash;
+}
+
 void FileResourceBase::setFilePath(const QString &filePath)
 {
     m_filePath = filePath;
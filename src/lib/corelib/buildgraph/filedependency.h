@@ -61,6 +61,13 @@ public:
     const FileTime &timestamp() const;
     void clearTimestamp() { m_timestamp.clear(); }
 
+    // A digest of the current file contents. Computed on demand and cached as long as the
+    // file's timestamp does not change. Empty if the file cannot be read.
+    const QByteArray &contentHash();
+
+    // The file's timestamp at the time contentHash() was computed.
+    const FileTime &contentHashTimestamp() const { return m_contentHashTimestamp; }
+
     void setFilePath(const QString &filePath);
     const QString &filePath() const;
     QString dirPath() const { return m_dirPath.toString(); }
@@ -73,9 +80,13 @@ private:
     template<PersistentPool::OpType opType> void serializationOp(PersistentPool &pool)
     {
         pool.serializationOp<opType>(m_filePath, m_timestamp);
+        if (pool.version() >= PersistentPool::MappedVersion)
+            pool.serializationOp<opType>(m_contentHash, m_contentHashTimestamp);
     }
 
     FileTime m_timestamp;
+    FileTime m_contentHashTimestamp;
+    QByteArray m_contentHash;
     QString m_filePath;
     QStringRef m_dirPath;
     QStringRef m_fileName;
@@ -49,22 +49,30 @@
 
 #include <language/language.h>
 #include <logging/categories.h>
+#include <tools/dependencyfileparser.h>
 #include <tools/fileinfo.h>
+#include <tools/filestatcache.h>
+#include <tools/parallelfor.h>
 #include <tools/scannerpluginmanager.h>
 #include <tools/qbsassert.h>
 #include <tools/error.h>
 #include <tools/qttools.h>
 
 #include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
 #include <QtCore/qstringlist.h>
+#include <QtCore/qthread.h>
 #include <QtCore/qvariant.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace qbs {
 namespace Internal {
 
 static void resolveDepencency(const RawScannedDependency &dependency,
-                              const ResolvedProduct *product, ResolvedDependency *result,
-                              const QString &baseDir = QString())
+                              const ResolvedProduct *product, FileStatCache &fileStatCache,
+                              ResolvedDependency *result, const QString &baseDir = QString())
 {
     QString absDirPath = baseDir.isEmpty()
             ? dependency.dirPath()
@@ -109,8 +117,8 @@ static void resolveDepencency(const RawScannedDependency &dependency,
             : absDirPath + QLatin1Char('/') + dependency.fileName();
 
     // TODO: We probably need a flag that tells us whether directories are allowed.
-    const FileInfo fi(absFilePath);
-    if (fi.exists(absFilePath) && !fi.isDir())
+    const FileInfo fi = fileStatCache.fileInfo(absFilePath);
+    if (fi.exists() && !fi.isDir())
         result->filePath = absFilePath;
 }
 
@@ -144,11 +152,30 @@ void InputArtifactScanner::scan()
     for (Artifact * const dependency : childrenAddedByScanner)
         disconnect(m_artifact, dependency);
 
+    // If the compiler tells us which files it has read, the C++ scanner is not needed.
+    // Before the command has run, the dependency file is the one from the last build, if any.
+    const ProcessCommand * const depFileCommand
+            = dependencyFileCommand(m_artifact->transformer.get());
     for (Artifact * const inputArtifact : qAsConst(m_artifact->transformer->inputs))
-        scanForFileDependencies(inputArtifact);
+        scanForFileDependencies(inputArtifact, !depFileCommand);
+    if (depFileCommand)
+        scanDependencyFile(depFileCommand);
+}
+
+const ProcessCommand *InputArtifactScanner::dependencyFileCommand(const Transformer *transformer)
+{
+    for (const AbstractCommandPtr &command : transformer->commands.commands()) {
+        if (command->type() != AbstractCommand::ProcessCommandType)
+            continue;
+        const auto processCommand = static_cast<const ProcessCommand *>(command.get());
+        if (!processCommand->dependencyFilePath().isEmpty())
+            return processCommand;
+    }
+    return nullptr;
 }
 
-void InputArtifactScanner::scanForFileDependencies(Artifact *inputArtifact)
+void InputArtifactScanner::scanForFileDependencies(Artifact *inputArtifact,
+                                                   bool useCppIncludeScanners)
 {
     qCDebug(lcDepScan) << "input artifact" << inputArtifact->filePath()
                        << inputArtifact->fileTags();
@@ -157,22 +184,123 @@ void InputArtifactScanner::scanForFileDependencies(Artifact *inputArtifact)
     Set<QString> visitedFilePaths;
     QList<FileResourceBase *> filesToScan;
     filesToScan.push_back(inputArtifact);
-    const Set<DependencyScanner *> scanners = scannersForArtifact(inputArtifact);
+    Set<DependencyScanner *> scanners = scannersForArtifact(inputArtifact);
+    if (!useCppIncludeScanners) {
+        const Set<DependencyScanner *> allScanners = scanners;
+        for (DependencyScanner * const scanner : allScanners) {
+            if (scanner->isCppIncludeScanner())
+                scanners.remove(scanner);
+        }
+    }
     if (scanners.empty())
         return;
     m_fileTagsForScanner
             = inputArtifact->fileTags().toStringList().join(QLatin1Char(',')).toLatin1();
     while (!filesToScan.empty()) {
-        FileResourceBase *fileToBeScanned = filesToScan.takeFirst();
-        const QString &filePathToBeScanned = fileToBeScanned->filePath();
-        if (!visitedFilePaths.insert(filePathToBeScanned).second)
-            continue;
+        // Files are handled one level of the include tree at a time, so that the ones that
+        // need to be parsed can be processed concurrently. The order in which the results
+        // are resolved is the same as when working through the queue one by one.
+        QList<FileResourceBase *> currentFiles;
+        for (FileResourceBase * const file : qAsConst(filesToScan)) {
+            if (visitedFilePaths.insert(file->filePath()).second)
+                currentFiles.push_back(file);
+        }
+        filesToScan.clear();
+        scanConcurrently(currentFiles, scanners);
+
+        for (FileResourceBase * const fileToBeScanned : qAsConst(currentFiles)) {
+            for (DependencyScanner * const scanner : scanners) {
+                scanForScannerFileDependencies(scanner, inputArtifact, fileToBeScanned,
+                    scanner->recursive() ? &filesToScan : nullptr, cacheItem[scanner->key()]);
+            }
+        }
+    }
+}
 
+// Brings the raw scan results of the given files up to date, using several threads.
+// Only the parsing happens concurrently; everything that touches the build graph stays
+// on the calling thread.
+void InputArtifactScanner::scanConcurrently(const QList<FileResourceBase *> &files,
+                                            const Set<DependencyScanner *> &scanners)
+{
+    struct ScanTask
+    {
+        DependencyScanner *scanner;
+        FileResourceBase *file;
+        RawScanResult result;
+        ErrorInfo error;
+    };
+    std::vector<ScanTask> tasks;
+    for (FileResourceBase * const file : files) {
         for (DependencyScanner * const scanner : scanners) {
-            scanForScannerFileDependencies(scanner, inputArtifact, fileToBeScanned,
-                scanner->recursive() ? &filesToScan : nullptr, cacheItem[scanner->key()]);
+            if (!scanner->isThreadSafe())
+                continue;
+            const RawScanResults::ScanData &scanData
+                    = m_rawScanResults.findScanData(file, scanner, m_artifact->properties);
+            if (scanData.lastScanTime < file->timestamp())
+                tasks.push_back(ScanTask{scanner, file, RawScanResult(), ErrorInfo()});
         }
     }
+    const int threadCount = std::min(QThread::idealThreadCount(), int(tasks.size()));
+    if (threadCount < 2)
+        return; // Not worth it; scanForScannerFileDependencies() will take care of the files.
+
+    qCDebug(lcDepScan) << "scanning" << tasks.size() << "files using" << threadCount
+                       << "threads";
+    parallelFor(tasks.size(), [this, &tasks](std::size_t i) {
+        try {
+            scanWithScannerPlugin(tasks[i].scanner, tasks[i].file, &tasks[i].result);
+        } catch (const ErrorInfo &error) {
+            tasks[i].error = error;
+        }
+    });
+
+    // The references returned by findScanData() are not stable, so look the entries up again.
+    // As in scanForScannerFileDependencies(), a file that could not be scanned only causes
+    // a warning.
+    const FileTime scanTime = FileTime::currentTime();
+    for (ScanTask &task : tasks) {
+        if (task.error.hasError()) {
+            m_logger.printWarning(task.error);
+            m_failedScans.insert(std::make_pair(task.scanner, task.file));
+            continue;
+        }
+        RawScanResults::ScanData &scanData
+                = m_rawScanResults.findScanData(task.file, task.scanner, m_artifact->properties);
+        scanData.rawScanResult = std::move(task.result);
+        scanData.lastScanTime = scanTime;
+    }
+}
+
+void InputArtifactScanner::scanDependencyFile(const ProcessCommand *command)
+{
+    const QString &depFilePath = command->dependencyFilePath();
+    qCDebug(lcDepScan) << "dependency file" << depFilePath;
+    QFile depFile(depFilePath);
+    if (!depFile.open(QIODevice::ReadOnly)) {
+        qCDebug(lcDepScan) << "cannot read dependency file:" << depFile.errorString();
+        return;
+    }
+    for (const QString &filePath : parseDependencyFile(depFile.readAll())) {
+        QString absoluteFilePath = QDir::fromNativeSeparators(filePath);
+        if (!FileInfo::isAbsolute(absoluteFilePath)) {
+            if (command->workingDir().isEmpty()) {
+                qCWarning(lcDepScan) << "ignoring relative path" << filePath
+                                     << "in dependency file" << depFilePath;
+                continue;
+            }
+            absoluteFilePath = FileInfo::resolvePath(command->workingDir(), absoluteFilePath);
+        }
+        ResolvedDependency dependency;
+        resolveDepencency(RawScannedDependency(absoluteFilePath), m_artifact->product.get(),
+                          *m_context->fileStatCache, &dependency);
+        // A header that was removed since the last compilation is not an error; the
+        // dependency file is up to date again after the next compilation.
+        if (dependency.isValid())
+            handleDependency(dependency);
+        else
+            qCDebug(lcDepScan) << "unresolved dependency " << absoluteFilePath;
+    }
 }
 
 Set<DependencyScanner *> InputArtifactScanner::scannersForArtifact(const Artifact *artifact) const
@@ -220,6 +348,8 @@ void InputArtifactScanner::scanForScannerFileDependencies(DependencyScanner *sca
     for (const QString &s : qAsConst(cache.searchPaths))
         qCDebug(lcDepScan) << "    " << s;
 
+    if (m_failedScans.contains(std::make_pair(scanner, fileToBeScanned)))
+        return; // Already reported by scanConcurrently().
     const QString &filePathToBeScanned = fileToBeScanned->filePath();
     RawScanResults::ScanData &scanData = m_rawScanResults.findScanData(fileToBeScanned, scanner,
                                                                        m_artifact->properties);
@@ -254,7 +384,8 @@ void InputArtifactScanner::resolveScanResultDependencies(const Artifact *inputAr
         cachedResolvedDependencyItem.valid = true;
 
         if (FileInfo::isAbsolute(dependencyFilePath)) {
-            resolveDepencency(dependency, inputArtifact->product.get(), &resolvedDependency);
+            resolveDepencency(dependency, inputArtifact->product.get(),
+                              *m_context->fileStatCache, &resolvedDependency);
             if (resolvedDependency.filePath.isEmpty())
                 goto unresolved;
             goto resolved;
@@ -263,7 +394,7 @@ void InputArtifactScanner::resolveScanResultDependencies(const Artifact *inputAr
         // try include paths
         for (const QString &includePath : cache.searchPaths) {
             resolveDepencency(dependency, inputArtifact->product.get(),
-                              &resolvedDependency, includePath);
+                              *m_context->fileStatCache, &resolvedDependency, includePath);
             if (resolvedDependency.isValid())
                 goto resolved;
         }
@@ -339,7 +470,8 @@ void InputArtifactScanner::handleDependency(ResolvedDependency &dependency)
     if (fileDependency) {
         m_artifact->fileDependencies << fileDependency;
         if (!fileDependency->timestamp().isValid())
-            fileDependency->setTimestamp(FileInfo(fileDependency->filePath()).lastModified());
+            fileDependency->setTimestamp(
+                        m_context->fileStatCache->lastModified(fileDependency->filePath()));
     } else {
         if (m_artifact->children.contains(artifactDependency))
             return;
@@ -48,6 +48,8 @@
 #include <QtCore/qhash.h>
 #include <QtCore/qstringlist.h>
 
+#include <utility>
+
 class ScannerPlugin;
 
 namespace qbs {
@@ -55,9 +57,12 @@ namespace Internal {
 
 class Artifact;
 class FileResourceBase;
+class FileStatCache;
+class ProcessCommand;
 class RawScanResult;
 class RawScanResults;
 class PropertyMapInternal;
+class Transformer;
 
 class DependencyScanner;
 typedef std::shared_ptr<DependencyScanner> DependencyScannerPtr;
@@ -73,6 +78,12 @@ public:
 
 class InputArtifactScannerContext
 {
+public:
+    explicit InputArtifactScannerContext(FileStatCache *fileStatCache)
+        : fileStatCache(fileStatCache)
+    {}
+
+private:
     struct ResolvedDependencyCacheItem
     {
         ResolvedDependencyCacheItem()
@@ -109,6 +120,7 @@ class InputArtifactScannerContext
 
     QHash<PropertyMapConstPtr, CacheItem> cache;
     QHash<ResolvedProduct*, QHash<FileTag, DependencyScannerCacheItem> > scannersCache;
+    FileStatCache * const fileStatCache;
 
     friend class InputArtifactScanner;
 };
@@ -121,8 +133,14 @@ public:
     void scan();
     bool newDependencyAdded() const { return m_newDependencyAdded; }
 
+    // Returns the command of the transformer that writes a dependency file, if there is one.
+    static const ProcessCommand *dependencyFileCommand(const Transformer *transformer);
+
 private:
-    void scanForFileDependencies(Artifact *inputArtifact);
+    void scanForFileDependencies(Artifact *inputArtifact, bool useCppIncludeScanners);
+    void scanDependencyFile(const ProcessCommand *command);
+    void scanConcurrently(const QList<FileResourceBase *> &files,
+                          const Set<DependencyScanner *> &scanners);
     Set<DependencyScanner *> scannersForArtifact(const Artifact *artifact) const;
     void scanForScannerFileDependencies(DependencyScanner *scanner,
             Artifact *inputArtifact, FileResourceBase *fileToBeScanned,
@@ -139,6 +157,7 @@ private:
     RawScanResults &m_rawScanResults;
     InputArtifactScannerContext *const m_context;
     QByteArray m_fileTagsForScanner;
+    Set<std::pair<DependencyScanner *, FileResourceBase *>> m_failedScans;
     bool m_newDependencyAdded;
     Logger m_logger;
 };
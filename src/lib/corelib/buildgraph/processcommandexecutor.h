@@ -62,6 +62,9 @@ public:
         m_buildEnvironment = processEnvironment;
     }
 
+    qint64 cpuTime() const { return m_process.cpuTime(); }
+    qint64 peakMemoryUsage() const { return m_process.peakMemoryUsage(); }
+
 signals:
     void reportProcessResult(const qbs::ProcessResult &result);
 
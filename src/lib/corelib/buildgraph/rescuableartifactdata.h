@@ -78,6 +78,8 @@ public:
                                      exportedModulesAccessedInCommands,
                                      lastPrepareScriptExecutionTime,
                                      lastCommandExecutionTime, fileTags, properties);
+        if (pool.version() >= PersistentPool::MappedVersion)
+            pool.serializationOp<opType>(commandResourceUsages, inputContentHashes);
     }
 
     bool isValid() const { return !!properties; }
@@ -119,6 +121,8 @@ public:
     RequestedArtifacts artifactsMapRequestedInCommands;
     FileTime lastPrepareScriptExecutionTime;
     FileTime lastCommandExecutionTime;
+    std::vector<CommandResourceUsage> commandResourceUsages;
+    std::unordered_map<QString, QByteArray> inputContentHashes;
     std::unordered_map<QString, ExportedModule> exportedModulesAccessedInPrepareScript;
     std::unordered_map<QString, ExportedModule> exportedModulesAccessedInCommands;
     bool knownOutOfDate = false;
@@ -54,6 +54,7 @@ namespace qbs {
 namespace Internal {
 
 static QString argumentsProperty() { return QStringLiteral("arguments"); }
+static QString dependencyFilePathProperty() { return QStringLiteral("dependencyFilePath"); }
 static QString environmentProperty() { return QStringLiteral("environment"); }
 static QString extendedDescriptionProperty() { return QStringLiteral("extendedDescription"); }
 static QString highlightProperty() { return QStringLiteral("highlight"); }
@@ -212,6 +213,8 @@ static QScriptValue js_Command(QScriptContext *context, QScriptEngine *engine)
                     engine->toScriptValue(commandPrototype->stdoutFilePath()));
     cmd.setProperty(stderrFilePathProperty(),
                     engine->toScriptValue(commandPrototype->stderrFilePath()));
+    cmd.setProperty(dependencyFilePathProperty(),
+                    engine->toScriptValue(commandPrototype->dependencyFilePath()));
     cmd.setProperty(environmentProperty(),
                     engine->toScriptValue(commandPrototype->environment().toStringList()));
     cmd.setProperty(ignoreDryRunProperty(),
@@ -271,6 +274,7 @@ bool ProcessCommand::equals(const AbstractCommand *otherAbstractCommand) const
             && m_responseFileUsagePrefix == other->m_responseFileUsagePrefix
             && m_stdoutFilePath == other->m_stdoutFilePath
             && m_stderrFilePath == other->m_stderrFilePath
+            && m_dependencyFilePath == other->m_dependencyFilePath
             && m_relevantEnvVars == other->m_relevantEnvVars
             && m_relevantEnvValues == other->m_relevantEnvValues
             && m_environment == other->m_environment;
@@ -308,6 +312,7 @@ void ProcessCommand::fillFromScriptValue(const QScriptValue *scriptValue, const
     getEnvironmentFromList(envList);
     m_stdoutFilePath = scriptValue->property(stdoutFilePathProperty()).toString();
     m_stderrFilePath = scriptValue->property(stderrFilePathProperty()).toString();
+    m_dependencyFilePath = scriptValue->property(dependencyFilePathProperty()).toString();
 
     m_predefinedProperties
             << programProperty()
@@ -321,7 +326,8 @@ void ProcessCommand::fillFromScriptValue(const QScriptValue *scriptValue, const
             << responseFileUsagePrefixProperty()
             << environmentProperty()
             << stdoutFilePathProperty()
-            << stderrFilePathProperty();
+            << stderrFilePathProperty()
+            << dependencyFilePathProperty();
     applyCommandProperties(scriptValue);
 }
 
@@ -433,7 +439,7 @@ void JavaScriptCommand::store(PersistentPool &pool)
 
 void CommandList::load(PersistentPool &pool)
 {
-    m_commands.clear();
+    clear();
     int count = pool.load<int>();
     m_commands.reserve(count);
     while (--count >= 0) {
@@ -139,6 +139,7 @@ public:
     QString relevantEnvValue(const QString &key) const { return m_relevantEnvValues.value(key); }
     QString stdoutFilePath() const { return m_stdoutFilePath; }
     QString stderrFilePath() const { return m_stderrFilePath; }
+    QString dependencyFilePath() const { return m_dependencyFilePath; }
 
     void load(PersistentPool &pool) override;
     void store(PersistentPool &pool) override;
@@ -158,6 +159,8 @@ private:
                                      m_responseFileThreshold, m_responseFileArgumentIndex,
                                      m_relevantEnvVars, m_relevantEnvValues, m_stdoutFilePath,
                                      m_stderrFilePath);
+        if (pool.version() >= PersistentPool::MappedVersion)
+            pool.serializationOp<opType>(m_dependencyFilePath);
     }
 
     QString m_program;
@@ -174,6 +177,7 @@ private:
     QProcessEnvironment m_relevantEnvValues;
     QString m_stdoutFilePath;
     QString m_stderrFilePath;
+    QString m_dependencyFilePath;
 };
 
 class JavaScriptCommand : public AbstractCommand
@@ -214,17 +218,45 @@ public:
     AbstractCommandPtr commandAt(int i) const { return m_commands.at(i); }
     const QList<AbstractCommandPtr> &commands() const { return m_commands; }
 
-    void clear() { m_commands.clear(); }
-    void addCommand(const AbstractCommandPtr &cmd) { m_commands.push_back(cmd); }
+    // The non-empty job pools of the commands. Kept up to date here, as the executor needs
+    // them several times for every transformer it considers for scheduling.
+    const Set<QString> &jobPools() const { return m_jobPools; }
+
+    void clear()
+    {
+        m_commands.clear();
+        m_jobPools.clear();
+    }
+    void addCommand(const AbstractCommandPtr &cmd)
+    {
+        m_commands.push_back(cmd);
+        if (!cmd->jobPool().isEmpty())
+            m_jobPools.insert(cmd->jobPool());
+    }
 
     void load(PersistentPool &pool);
     void store(PersistentPool &pool) const;
 private:
     QList<AbstractCommandPtr> m_commands;
+    Set<QString> m_jobPools;
 };
 bool operator==(const CommandList &cl1, const CommandList &cl2);
 inline bool operator!=(const CommandList &cl1, const CommandList &cl2) { return !(cl1 == cl2); }
 
+// Resources consumed by one command of a transformer the last time it was run.
+class CommandResourceUsage
+{
+public:
+    template<PersistentPool::OpType opType> void completeSerializationOp(PersistentPool &pool)
+    {
+        pool.serializationOp<opType>(wallTime, cpuTime, peakMemoryUsage);
+    }
+
+    qint64 wallTime = -1; // In milliseconds.
+    qint64 cpuTime = -1; // In milliseconds, negative if unknown.
+    qint64 peakMemoryUsage = -1; // In bytes, negative if unknown.
+};
+
 } // namespace Internal
 } // namespace qbs
 
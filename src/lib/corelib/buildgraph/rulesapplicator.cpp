@@ -288,6 +288,8 @@ void RulesApplicator::doApply(const ArtifactSet &inputArtifacts, QScriptValue &p
             outputArtifact->pureProperties.push_back(std::make_pair(binding.name, value));
         }
         outputArtifact->properties->setValue(artifactModulesCfg);
+        outputArtifact->properties = m_product->topLevelProject()->propertyMapInterner
+                .intern(outputArtifact->properties);
         if (!outputInfo.newlyCreated && (outputArtifact->fileTags() != outputInfo.oldFileTags
                 || outputArtifact->properties->value() != outputInfo.oldProperties)) {
             invalidateArtifactAsRuleInputIfNecessary(outputArtifact);
@@ -608,6 +610,8 @@ public:
             outputArtifact->pureProperties.push_back(std::make_pair(key, e.value));
         }
         outputArtifact->properties->setValue(artifactCfg);
+        outputArtifact->properties = outputArtifact->product->topLevelProject()
+                ->propertyMapInterner.intern(outputArtifact->properties);
     }
 };
 
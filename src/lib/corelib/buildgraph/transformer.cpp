@@ -311,6 +311,8 @@ void Transformer::rescueChangeTrackingData(const TransformerConstPtr &other)
     artifactsMapRequestedInCommands = other->artifactsMapRequestedInCommands;
     lastCommandExecutionTime = other->lastCommandExecutionTime;
     lastPrepareScriptExecutionTime = other->lastPrepareScriptExecutionTime;
+    commandResourceUsages = other->commandResourceUsages;
+    inputContentHashes = other->inputContentHashes;
     prepareScriptNeedsChangeTracking = other->prepareScriptNeedsChangeTracking;
     commandsNeedChangeTracking = other->commandsNeedChangeTracking;
     markedForRerun = other->markedForRerun;
@@ -318,14 +320,16 @@ void Transformer::rescueChangeTrackingData(const TransformerConstPtr &other)
     exportedModulesAccessedInCommands = other->exportedModulesAccessedInCommands;
 }
 
-Set<QString> Transformer::jobPools() const
+// The sum of the wall times of the commands the last time they were run, in milliseconds.
+// Negative if the current commands have not all run yet.
+qint64 Transformer::lastExecutionDuration() const
 {
-    Set<QString> pools;
-    for (const AbstractCommandPtr &c : commands.commands()) {
-        if (!c->jobPool().isEmpty())
-            pools.insert(c->jobPool());
-    }
-    return pools;
+    if (commandResourceUsages.size() != std::size_t(commands.size()))
+        return -1;
+    qint64 duration = 0;
+    for (const CommandResourceUsage &usage : commandResourceUsages)
+        duration += usage.wallTime;
+    return duration;
 }
 
 } // namespace Internal
@@ -84,6 +84,11 @@ public:
     RequestedArtifacts artifactsMapRequestedInCommands;
     FileTime lastPrepareScriptExecutionTime;
     FileTime lastCommandExecutionTime;
+    std::vector<CommandResourceUsage> commandResourceUsages; // Parallel to "commands".
+
+    // Digests of the children and file dependencies of the outputs, taken when the commands
+    // last ran. Only recorded if BuildOptions::contentHashCheck() is enabled.
+    std::unordered_map<QString, QByteArray> inputContentHashes;
     std::unordered_map<QString, ExportedModule> exportedModulesAccessedInPrepareScript;
     std::unordered_map<QString, ExportedModule> exportedModulesAccessedInCommands;
     bool alwaysRun;
@@ -102,7 +107,8 @@ public:
                         const QScriptValueList &args);
     void rescueChangeTrackingData(const TransformerConstPtr &other);
 
-    Set<QString> jobPools() const;
+    const Set<QString> &jobPools() const { return commands.jobPools(); }
+    qint64 lastExecutionDuration() const;
 
     template<PersistentPool::OpType opType> void completeSerializationOp(PersistentPool &pool)
     {
@@ -120,6 +126,8 @@ public:
                                      exportedModulesAccessedInCommands,
                                      alwaysRun, prepareScriptNeedsChangeTracking,
                                      commandsNeedChangeTracking, markedForRerun);
+        if (pool.version() >= PersistentPool::MappedVersion)
+            pool.serializationOp<opType>(commandResourceUsages, inputContentHashes);
     }
 
 private:
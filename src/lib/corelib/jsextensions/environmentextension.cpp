@@ -94,6 +94,7 @@ QScriptValue EnvironmentExtension::js_getEnv(QScriptContext *context, QScriptEng
 
     const QString name = context->argument(0).toString();
     const QString value = procenv->value(name);
+    static_cast<ScriptEngine *>(engine)->addEnvironmentQuery(name, value);
     return value.isNull() ? engine->undefinedValue() : value;
 }
 
@@ -126,6 +127,7 @@ QScriptValue EnvironmentExtension::js_currentEnv(QScriptContext *context, QScrip
                                                                QStringLiteral("currentEnv"), false);
     if (!procenv)
         procenv = &env;
+    static_cast<ScriptEngine *>(engine)->setWholeEnvironmentQueried();
     QScriptValue envObject = engine->newObject();
     for (const QString &key : procenv->keys()) {
         const QString keyName = HostOsInfo::isWindowsHost() ? key.toUpper() : key;
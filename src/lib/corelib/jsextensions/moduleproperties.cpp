@@ -73,16 +73,18 @@ QScriptValue getDataForModuleScriptValue(QScriptEngine *engine, const ResolvedPr
 }
 
 static QScriptValue getModuleProperty(const ResolvedProduct *product, const Artifact *artifact,
-                                      ScriptEngine *engine, const QString &moduleName,
-                                      const QString &propertyName, bool *isPresent = nullptr)
+                                      ScriptEngine *engine, const ModulePropertyPath &path,
+                                      bool *isPresent = nullptr)
 {
+    const QString &moduleName = path.moduleName();
+    const QString &propertyName = path.propertyName();
     const PropertyMapConstPtr &properties = artifact ? artifact->properties
                                                      : product->moduleProperties;
     QVariant value;
     if (engine->isPropertyCacheEnabled())
         value = engine->retrieveFromPropertyCache(moduleName, propertyName, properties);
     if (!value.isValid()) {
-        value = properties->moduleProperty(moduleName, propertyName, isPresent);
+        value = properties->moduleProperty(path, isPresent);
 
         // Cache the variant value. We must not cache the QScriptValue here, because it's a
         // reference and the user might change the actual object.
@@ -133,7 +135,7 @@ private:
         QBS_ASSERT(m_product || m_artifact, return QueryFlags());
         bool isPresent;
         m_result = getModuleProperty(m_product, m_artifact, static_cast<ScriptEngine *>(engine()),
-                                     m_moduleName, name, &isPresent);
+                                     ModulePropertyPath(m_moduleName, name), &isPresent);
 
         // It is important that we reject unknown property names. Otherwise QtScript will forward
         // *everything* to us, including built-in stuff like the hasOwnProperty function.
@@ -346,9 +348,9 @@ QScriptValue ModuleProperties::moduleProperty(QScriptContext *context, QScriptEn
     }
 
     const auto qbsEngine = static_cast<ScriptEngine *>(engine);
-    const QString moduleName = context->argument(0).toString();
-    const QString propertyName = context->argument(1).toString();
-    return getModuleProperty(product, artifact, qbsEngine, moduleName, propertyName);
+    const ModulePropertyPath path(context->argument(0).toString(),
+                                  context->argument(1).toString());
+    return getModuleProperty(product, artifact, qbsEngine, path);
 }
 
 } // namespace Internal
@@ -0,0 +1,96 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include "astcache.h"
+
+#include <parser/qmljsengine_p.h>
+
+#include <algorithm>
+
+namespace qbs {
+namespace Internal {
+
+ParsedFile::ParsedFile() : engine(new QbsQmlJS::Engine)
+{
+}
+
+ParsedFile::~ParsedFile()
+{
+}
+
+ASTCache::ASTCache(int maxEntryCount) : m_maxEntryCount(std::max(maxEntryCount, 1))
+{
+}
+
+ParsedFileConstPtr ASTCache::value(const QString &filePath, const FileTime &lastModified)
+{
+    if (!lastModified.isValid())
+        return ParsedFileConstPtr();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_entries.find(filePath);
+    if (it == m_entries.end() || it->lastModified != lastModified)
+        return ParsedFileConstPtr();
+    it->lastUse = ++m_useCount;
+    return it->file;
+}
+
+void ASTCache::insert(const QString &filePath, const FileTime &lastModified,
+                      const ParsedFileConstPtr &file)
+{
+    if (!lastModified.isValid())
+        return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_entries.contains(filePath) && m_entries.size() >= m_maxEntryCount) {
+        const auto leastRecentlyUsed = std::min_element(m_entries.begin(), m_entries.end(),
+                [](const Entry &e1, const Entry &e2) { return e1.lastUse < e2.lastUse; });
+        m_entries.erase(leastRecentlyUsed);
+    }
+    Entry &entry = m_entries[filePath];
+    entry.lastModified = lastModified;
+    entry.file = file;
+    entry.lastUse = ++m_useCount;
+}
+
+int ASTCache::count() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+} // namespace Internal
+} // namespace qbs
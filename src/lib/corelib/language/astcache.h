@@ -0,0 +1,105 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#ifndef QBS_ASTCACHE_H
+#define QBS_ASTCACHE_H
+
+#include "forward_decls.h"
+
+#include <parser/qmljsastfwd_p.h>
+#include <tools/filetime.h>
+#include <tools/qbs_export.h>
+
+#include <QtCore/qhash.h>
+#include <QtCore/qstring.h>
+
+#include <memory>
+#include <mutex>
+
+namespace QbsQmlJS { class Engine; }
+
+namespace qbs {
+namespace Internal {
+
+class ParsedFile
+{
+    Q_DISABLE_COPY(ParsedFile)
+public:
+    ParsedFile();
+    ~ParsedFile();
+
+    QString code;
+    const std::unique_ptr<QbsQmlJS::Engine> engine;
+    QbsQmlJS::AST::UiProgram *ast = nullptr;
+};
+
+/*
+ * Holds the parsed project and module files of a resolve, so that each file is lexed and
+ * parsed only once. The cache is handed on from a project to the next resolve of the same
+ * project, e.g. when an IDE resolves again after a change of the profile.
+ * An entry is only used if the file's timestamp has not changed since it was read. At most
+ * maxEntryCount entries are kept; the one that was used least recently is dropped first.
+ */
+class QBS_AUTOTEST_EXPORT ASTCache
+{
+public:
+    explicit ASTCache(int maxEntryCount = 2000);
+
+    ParsedFileConstPtr value(const QString &filePath, const FileTime &lastModified);
+    void insert(const QString &filePath, const FileTime &lastModified,
+                const ParsedFileConstPtr &file);
+    int count() const;
+
+private:
+    struct Entry
+    {
+        FileTime lastModified;
+        ParsedFileConstPtr file;
+        quint64 lastUse = 0;
+    };
+
+    const int m_maxEntryCount;
+    mutable std::mutex m_mutex;
+    QHash<QString, Entry> m_entries;
+    quint64 m_useCount = 0;
+};
+
+} // namespace Internal
+} // namespace qbs
+
+#endif // Include guard.
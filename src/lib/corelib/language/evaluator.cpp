@@ -247,6 +247,22 @@ void Evaluator::clearPropertyDependencies()
     m_scriptClass->clearPropertyDependencies();
 }
 
+void Evaluator::addPropertyDependencies(const PropertyDependencies &dependencies)
+{
+    m_scriptClass->addPropertyDependencies(dependencies);
+}
+
+void Evaluator::setEvaluationRecord(EvaluationRecord *record)
+{
+    m_scriptClass->setEvaluationRecord(record);
+}
+
+bool Evaluator::hasCachedValues(const Item *item) const
+{
+    const auto data = attachedPointer<EvaluationData>(m_scriptValueMap.value(item));
+    return data && !data->valueCache.empty();
+}
+
 void throwOnEvaluationError(ScriptEngine *engine, const QScriptValue &scriptValue,
                             const std::function<CodeLocation()> &provideFallbackCodeLocation)
 {
@@ -49,15 +49,35 @@
 #include <QtScript/qscriptvalue.h>
 
 #include <functional>
+#include <vector>
 
 namespace qbs {
 namespace Internal {
 class EvaluatorScriptClass;
 class FileTags;
+class Item;
 class Logger;
 class PropertyDeclaration;
 class ScriptEngine;
 
+// Describes what an evaluation depended on, so that its results can be reused in a
+// context where all the recorded reads yield the same values.
+struct EvaluationRecord
+{
+    struct PropertyRead
+    {
+        const Item *item = nullptr;
+        QString name;
+        const Item *itemValue = nullptr; // Set if the property is an item value.
+        QScriptValue value;
+    };
+
+    std::vector<PropertyRead> propertyReads;
+    PropertyDependencies propertyDependencies;
+    bool usesPathPropertiesBaseDir = false;
+    bool complete = true; // False if the evaluation depended on something not recorded here.
+};
+
 class QBS_AUTOTEST_EXPORT Evaluator : private ItemObserver
 {
     friend class SVConverter;
@@ -96,6 +116,10 @@ public:
 
     PropertyDependencies propertyDependencies() const;
     void clearPropertyDependencies();
+    void addPropertyDependencies(const PropertyDependencies &dependencies);
+
+    void setEvaluationRecord(EvaluationRecord *record);
+    bool hasCachedValues(const Item *item) const;
 
     void handleEvaluationError(const Item *item, const QString &name,
             const QScriptValue &scriptValue);
@@ -127,8 +127,8 @@ private:
     {
         if (!extraScope->isObject())
             *extraScope = engine->newObject();
-        const PropertyDeclaration::Type type
-                = itemOfProperty->propertyDeclaration(propertyName->toString()).type();
+        const QString &name = scriptClass->propertyName(*propertyName);
+        const PropertyDeclaration::Type type = itemOfProperty->propertyDeclaration(name).type();
         const bool isArray = type == PropertyDeclaration::StringList
                 || type == PropertyDeclaration::PathList
                 || type == PropertyDeclaration::Variant // TODO: Why?
@@ -175,7 +175,8 @@ private:
         }
         if (value->sourceUsesOriginal()) {
             QScriptValue originalValue;
-            if (data->item->propertyDeclaration(propertyName->toString()).isScalar()) {
+            const QString &name = scriptClass->propertyName(*propertyName);
+            if (data->item->propertyDeclaration(name).isScalar()) {
                 const Item *item = itemOfProperty;
                 if (item->type() == ItemType::Module || item->type() == ItemType::Export) {
                     const QString errorMessage = Tr::tr("The special value 'original' cannot "
@@ -190,7 +191,7 @@ private:
                 if (item->type() == ItemType::ModuleInstance
                         && !item->hasProperty(StringConstants::presentProperty())) {
                     const QString errorMessage = Tr::tr("Trying to assign property '%1' "
-                            "on something that is not a module.").arg(propertyName->toString());
+                            "on something that is not a module.").arg(name);
                     extraScope = engine->currentContext()->throwError(errorMessage);
                     result.second = false;
                     return result;
@@ -364,9 +365,20 @@ enum QueryPropertyType
 EvaluatorScriptClass::EvaluatorScriptClass(ScriptEngine *scriptEngine)
     : QScriptClass(scriptEngine)
     , m_valueCacheEnabled(false)
+    , m_parentPropertyName(scriptEngine->toStringHandle(QStringLiteral("parent")))
 {
 }
 
+// QScriptString is the engine's interned representation of an identifier, so comparing and
+// hashing it is cheap, whereas converting it to a QString allocates every time.
+const QString &EvaluatorScriptClass::propertyName(const QScriptString &name)
+{
+    auto it = m_propertyNames.find(name);
+    if (it == m_propertyNames.end())
+        it = m_propertyNames.insert(name, name.toString());
+    return it.value();
+}
+
 QScriptClass::QueryFlags EvaluatorScriptClass::queryProperty(const QScriptValue &object,
                                                              const QScriptString &name,
                                                              QScriptClass::QueryFlags flags,
@@ -382,8 +394,7 @@ QScriptClass::QueryFlags EvaluatorScriptClass::queryProperty(const QScriptValue
         qDebug() << "[SC] queryProperty " << object.objectId() << " " << name;
 
     auto const data = attachedPointer<EvaluationData>(object);
-    const QString nameString = name.toString();
-    if (nameString == QStringLiteral("parent")) {
+    if (name == m_parentPropertyName) {
         *id = QPTParentProperty;
         m_queryResult.data = data;
         return QScriptClass::HandlesReadAccess;
@@ -396,7 +407,7 @@ QScriptClass::QueryFlags EvaluatorScriptClass::queryProperty(const QScriptValue
         return QScriptClass::QueryFlags();
     }
 
-    return queryItemProperty(data, nameString);
+    return queryItemProperty(data, propertyName(name));
 }
 
 QScriptClass::QueryFlags EvaluatorScriptClass::queryItemProperty(const EvaluationData *data,
@@ -597,6 +608,21 @@ void EvaluatorScriptClass::convertToPropertyType(const PropertyDeclaration &decl
     convertToPropertyType_impl(QString(), nullptr, decl, loc, v);
 }
 
+static bool containsRelativePath(const QScriptValue &v)
+{
+    if (v.isString())
+        return !FileInfo::isAbsolute(v.toString());
+    if (!v.isArray())
+        return false;
+    const quint32 c = v.property(StringConstants::lengthProperty()).toUInt32();
+    for (quint32 i = 0; i < c; ++i) {
+        const QScriptValue elem = v.property(i);
+        if (elem.isString() && !FileInfo::isAbsolute(elem.toString()))
+            return true;
+    }
+    return false;
+}
+
 void EvaluatorScriptClass::convertToPropertyType(const Item *item, const PropertyDeclaration& decl,
                                                  const Value *value, QScriptValue &v)
 {
@@ -604,6 +630,12 @@ void EvaluatorScriptClass::convertToPropertyType(const Item *item, const Propert
         v = v.engine()->newArray(); // QTBUG-51237
         return;
     }
+    if (m_evaluationRecord && !m_pathPropertiesBaseDir.isEmpty()
+            && (decl.type() == PropertyDeclaration::Path
+                || decl.type() == PropertyDeclaration::PathList)
+            && containsRelativePath(v)) {
+        m_evaluationRecord->usesPathPropertiesBaseDir = true;
+    }
     convertToPropertyType_impl(m_pathPropertiesBaseDir, item, decl, value->location(), v);
 }
 
@@ -612,7 +644,8 @@ class PropertyStackManager
 public:
     PropertyStackManager(const Item *itemOfProperty, const QScriptString &name, const Value *value,
                          std::stack<QualifiedId> &requestedProperties,
-                         PropertyDependencies &propertyDependencies)
+                         PropertyDependencies &propertyDependencies,
+                         EvaluationRecord *evaluationRecord)
         : m_requestedProperties(requestedProperties)
     {
         if (value->type() == Value::JSSourceValueType
@@ -625,8 +658,13 @@ public:
             m_stackUpdate = true;
             const QualifiedId fullPropName
                     = QualifiedId::fromString(varValue->value().toString()) << name.toString();
-            if (!requestedProperties.empty())
+            if (!requestedProperties.empty()) {
                 propertyDependencies[fullPropName].insert(requestedProperties.top());
+                if (evaluationRecord) {
+                    evaluationRecord->propertyDependencies[fullPropName]
+                            .insert(requestedProperties.top());
+                }
+            }
             m_requestedProperties.push(fullPropName);
         }
     }
@@ -655,6 +693,8 @@ QScriptValue EvaluatorScriptClass::property(const QScriptValue &object, const QS
 
     const auto qpt = static_cast<QueryPropertyType>(id);
     if (qpt == QPTParentProperty) {
+        if (m_evaluationRecord)
+            m_evaluationRecord->complete = false;
         return data->item->parent()
                 ? data->evaluator->scriptValue(data->item->parent())
                 : engine()->undefinedValue();
@@ -669,7 +709,10 @@ QScriptValue EvaluatorScriptClass::property(const QScriptValue &object, const QS
         qDebug() << "[SC] property " << name;
 
     PropertyStackManager propStackmanager(itemOfProperty, name, value.get(),
-                                          m_requestedProperties, m_propertyDependencies);
+                                          m_requestedProperties, m_propertyDependencies,
+                                          m_evaluationRecord);
+    if (m_evaluationRecord && foundInParent)
+        m_evaluationRecord->complete = false;
 
     QScriptValue result;
     if (m_valueCacheEnabled) {
@@ -677,12 +720,13 @@ QScriptValue EvaluatorScriptClass::property(const QScriptValue &object, const QS
         if (result.isValid()) {
             if (debugProperties)
                 qDebug() << "[SC] cache hit " << name << ": " << resultToString(result);
+            recordPropertyRead(data, name, value.get(), result);
             return result;
         }
     }
 
     if (value->next() && !m_currentNextChain.contains(value.get())) {
-        collectValuesFromNextChain(data, &result, name.toString(), value);
+        collectValuesFromNextChain(data, &result, propertyName(name), value);
     } else {
         QScriptValue parentObject;
         if (foundInParent)
@@ -691,7 +735,7 @@ QScriptValue EvaluatorScriptClass::property(const QScriptValue &object, const QS
                               &name, data, &result);
         converter.start();
 
-        const PropertyDeclaration decl = data->item->propertyDeclaration(name.toString());
+        const PropertyDeclaration decl = data->item->propertyDeclaration(propertyName(name));
         convertToPropertyType(data->item, decl, value.get(), result);
     }
 
@@ -699,9 +743,25 @@ QScriptValue EvaluatorScriptClass::property(const QScriptValue &object, const QS
         qDebug() << "[SC] cache miss " << name << ": " << resultToString(result);
     if (m_valueCacheEnabled)
         data->valueCache.insert(name, result);
+    recordPropertyRead(data, name, value.get(), result);
     return result;
 }
 
+void EvaluatorScriptClass::recordPropertyRead(const EvaluationData *data, const QScriptString &name,
+                                              const Value *value, const QScriptValue &result)
+{
+    if (!m_evaluationRecord)
+        return;
+    EvaluationRecord::PropertyRead read;
+    read.item = data->item;
+    read.name = propertyName(name);
+    if (value->type() == Value::ItemValueType)
+        read.itemValue = static_cast<const ItemValue *>(value)->item();
+    else
+        read.value = result;
+    m_evaluationRecord->propertyReads.push_back(read);
+}
+
 class EvaluatorScriptClassPropertyIterator : public QScriptClassPropertyIterator
 {
 public:
@@ -751,10 +811,18 @@ private:
 
 QScriptClassPropertyIterator *EvaluatorScriptClass::newIterator(const QScriptValue &object)
 {
+    if (m_evaluationRecord)
+        m_evaluationRecord->complete = false;
     auto const data = attachedPointer<EvaluationData>(object);
     return data ? new EvaluatorScriptClassPropertyIterator(object, data) : nullptr;
 }
 
+void EvaluatorScriptClass::addPropertyDependencies(const PropertyDependencies &dependencies)
+{
+    for (auto it = dependencies.cbegin(); it != dependencies.cend(); ++it)
+        m_propertyDependencies[it.key()].unite(it.value());
+}
+
 void EvaluatorScriptClass::setValueCacheEnabled(bool enabled)
 {
     m_valueCacheEnabled = enabled;
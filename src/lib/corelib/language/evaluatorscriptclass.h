@@ -56,6 +56,7 @@ QT_END_NAMESPACE
 namespace qbs {
 namespace Internal {
 class EvaluationData;
+struct EvaluationRecord;
 class Item;
 class PropertyDeclaration;
 class ScriptEngine;
@@ -79,10 +80,15 @@ public:
 
     PropertyDependencies propertyDependencies() const { return m_propertyDependencies; }
     void clearPropertyDependencies() { m_propertyDependencies.clear(); }
+    void addPropertyDependencies(const PropertyDependencies &dependencies);
+
+    void setEvaluationRecord(EvaluationRecord *record) { m_evaluationRecord = record; }
 
     void setPathPropertiesBaseDir(const QString &dirPath) { m_pathPropertiesBaseDir = dirPath; }
     void clearPathPropertiesBaseDir() { m_pathPropertiesBaseDir.clear(); }
 
+    const QString &propertyName(const QScriptString &name);
+
 private:
     QueryFlags queryItemProperty(const EvaluationData *data,
                                  const QString &name,
@@ -93,6 +99,8 @@ private:
     void convertToPropertyType(const Item *item,
                                const PropertyDeclaration& decl, const Value *value,
                                QScriptValue &v);
+    void recordPropertyRead(const EvaluationData *data, const QScriptString &name,
+                            const Value *value, const QScriptValue &result);
 
     struct QueryResult
     {
@@ -121,10 +129,13 @@ private:
     };
     QueryResult m_queryResult;
     bool m_valueCacheEnabled;
+    const QScriptString m_parentPropertyName;
+    QHash<QScriptString, QString> m_propertyNames;
     Set<Value *> m_currentNextChain;
     PropertyDependencies m_propertyDependencies;
     std::stack<QualifiedId> m_requestedProperties;
     QString m_pathPropertiesBaseDir;
+    EvaluationRecord *m_evaluationRecord = nullptr;
 };
 
 } // namespace Internal
@@ -70,6 +70,12 @@ class FileContextBase;
 typedef std::shared_ptr<FileContextBase> FileContextBasePtr;
 typedef std::shared_ptr<const FileContextBase> FileContextBaseConstPtr;
 
+class ASTCache;
+typedef std::shared_ptr<ASTCache> ASTCachePtr;
+
+class ParsedFile;
+typedef std::shared_ptr<const ParsedFile> ParsedFileConstPtr;
+
 class Probe;
 typedef std::shared_ptr<Probe> ProbePtr;
 typedef std::shared_ptr<const Probe> ProbeConstPtr;
@@ -131,6 +131,11 @@ Set<QString> ItemReader::filesRead() const
     return m_visitorState->filesRead();
 }
 
+void ItemReader::setASTCache(const ASTCachePtr &cache)
+{
+    m_visitorState->setASTCache(cache);
+}
+
 void ItemReader::setEnableTiming(bool on)
 {
     m_elapsedTime = on ? 0 : -1;
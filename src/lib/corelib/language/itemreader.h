@@ -81,6 +81,8 @@ public:
 
     Set<QString> filesRead() const;
 
+    void setASTCache(const ASTCachePtr &cache);
+
     void setEnableTiming(bool on);
     qint64 elapsedTime() const { return m_elapsedTime; }
 
@@ -198,7 +198,7 @@ bool ItemReaderASTVisitor::visit(AST::UiPublicMember *ast)
         throw ErrorInfo(Tr::tr("public member without type"));
     if (Q_UNLIKELY(ast->type == AST::UiPublicMember::Signal))
         throw ErrorInfo(Tr::tr("public member with signal type not supported"));
-    p.setName(ast->name.toString());
+    p.setName(m_visitorState.internedPropertyName(ast->name.toString()));
     p.setType(PropertyDeclaration::propertyTypeFromString(ast->memberType.toString()));
     if (p.type() == PropertyDeclaration::UnknownType) {
         throw ErrorInfo(Tr::tr("Unknown type '%1' in property declaration.")
@@ -230,7 +230,9 @@ bool ItemReaderASTVisitor::visit(AST::UiScriptBinding *ast)
     QBS_CHECK(ast->qualifiedId);
     QBS_CHECK(!ast->qualifiedId->name.isEmpty());
 
-    const QStringList bindingName = toStringList(ast->qualifiedId);
+    QStringList bindingName = toStringList(ast->qualifiedId);
+    for (QString &namePart : bindingName)
+        namePart = m_visitorState.internedPropertyName(namePart);
 
     if (bindingName.length() == 1 && bindingName.front() == QStringLiteral("id")) {
         const auto * const expStmt = AST::cast<AST::ExpressionStatement *>(ast->statement);
@@ -38,6 +38,7 @@
 ****************************************************************************/
 #include "itemreadervisitorstate.h"
 
+#include "astcache.h"
 #include "asttools.h"
 #include "filecontext.h"
 #include "itemreaderastvisitor.h"
@@ -47,97 +48,50 @@
 #include <parser/qmljslexer_p.h>
 #include <parser/qmljsparser_p.h>
 #include <tools/error.h>
+#include <tools/fileinfo.h>
+#include <tools/qbsassert.h>
 
-#include <QtCore/qshareddata.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qfileinfo.h>
-#include <QtCore/qshareddata.h>
 #include <QtCore/qtextstream.h>
 
 namespace qbs {
 namespace Internal {
 
-class ASTCacheValueData : public QSharedData
-{
-    Q_DISABLE_COPY(ASTCacheValueData)
-public:
-    ASTCacheValueData()
-        : ast(nullptr)
-        , processing(false)
-    {
-    }
-
-    QString code;
-    QbsQmlJS::Engine engine;
-    QbsQmlJS::AST::UiProgram *ast;
-    bool processing;
-};
-
-class ASTCacheValue
-{
-public:
-    ASTCacheValue()
-        : d(new ASTCacheValueData)
-    {
-    }
-
-    ASTCacheValue(const ASTCacheValue &other)
-        : d(other.d)
-    {
-    }
-
-    void setProcessingFlag(bool b) { d->processing = b; }
-    bool isProcessing() const { return d->processing; }
-
-    void setCode(const QString &code) { d->code = code; }
-    QString code() const { return d->code; }
-
-    QbsQmlJS::Engine *engine() const { return &d->engine; }
-
-    void setAst(QbsQmlJS::AST::UiProgram *ast) { d->ast = ast; }
-    QbsQmlJS::AST::UiProgram *ast() const { return d->ast; }
-    bool isValid() const { return d->ast; }
-
-private:
-    QExplicitlySharedDataPointer<ASTCacheValueData> d;
-};
-
-class ItemReaderVisitorState::ASTCache : public QHash<QString, ASTCacheValue> {};
-
-
 ItemReaderVisitorState::ItemReaderVisitorState(Logger &logger)
     : m_logger(logger)
-    , m_astCache(new ASTCache)
+    , m_astCache(std::make_shared<ASTCache>())
 {
 
 }
 
 ItemReaderVisitorState::~ItemReaderVisitorState()
 {
-    delete m_astCache;
 }
 
 Item *ItemReaderVisitorState::readFile(const QString &filePath, const QStringList &searchPaths,
                                   ItemPool *itemPool)
 {
-    ASTCacheValue &cacheValue = (*m_astCache)[filePath];
-    if (cacheValue.isValid()) {
-        if (Q_UNLIKELY(cacheValue.isProcessing()))
-            throw ErrorInfo(Tr::tr("Loop detected when importing '%1'.").arg(filePath));
-    } else {
-        QFile file(filePath);
-        if (Q_UNLIKELY(!file.open(QFile::ReadOnly)))
-            throw ErrorInfo(Tr::tr("Cannot open '%1'.").arg(filePath));
-
-        m_filesRead.insert(filePath);
-        QTextStream stream(&file);
-        stream.setCodec("UTF-8");
-        const QString &code = stream.readAll();
-        QbsQmlJS::Lexer lexer(cacheValue.engine());
-        lexer.setCode(code, 1);
-        QbsQmlJS::Parser parser(cacheValue.engine());
-
-        file.close();
+    if (Q_UNLIKELY(m_filesBeingProcessed.contains(filePath)))
+        throw ErrorInfo(Tr::tr("Loop detected when importing '%1'.").arg(filePath));
+
+    const FileTime lastModified = FileInfo(filePath).lastModified();
+    ParsedFileConstPtr parsedFile = m_astCache->value(filePath, lastModified);
+    if (!parsedFile) {
+        const auto newParsedFile = std::make_shared<ParsedFile>();
+        {
+            QFile file(filePath);
+            if (Q_UNLIKELY(!file.open(QFile::ReadOnly)))
+                throw ErrorInfo(Tr::tr("Cannot open '%1'.").arg(filePath));
+
+            QTextStream stream(&file);
+            stream.setCodec("UTF-8");
+            newParsedFile->code = stream.readAll();
+        }
+        QbsQmlJS::Lexer lexer(newParsedFile->engine.get());
+        lexer.setCode(newParsedFile->code, 1);
+        QbsQmlJS::Parser parser(newParsedFile->engine.get());
+
         if (!parser.parse()) {
             const QList<QbsQmlJS::DiagnosticMessage> &parserMessages = parser.diagnosticMessages();
             if (Q_UNLIKELY(!parserMessages.empty())) {
@@ -148,25 +102,32 @@ Item *ItemReaderVisitorState::readFile(const QString &filePath, const QStringLis
             }
         }
 
-        cacheValue.setCode(code);
-        cacheValue.setAst(parser.ast());
+        newParsedFile->ast = parser.ast();
+
+        // The timestamp was taken before reading, so a file that changes in between
+        // gets parsed again the next time.
+        m_astCache->insert(filePath, lastModified, newParsedFile);
+        parsedFile = newParsedFile;
     }
+    m_filesRead.insert(filePath);
 
     const FileContextPtr file = FileContext::create();
     file->setFilePath(QFileInfo(filePath).absoluteFilePath());
-    file->setContent(cacheValue.code());
+    file->setContent(parsedFile->code);
     file->setSearchPaths(searchPaths);
 
     ItemReaderASTVisitor astVisitor(*this, file, itemPool, m_logger);
     {
         class ProcessingFlagManager {
         public:
-            ProcessingFlagManager(ASTCacheValue &v) : m_cacheValue(v) { v.setProcessingFlag(true); }
-            ~ProcessingFlagManager() { m_cacheValue.setProcessingFlag(false); }
+            ProcessingFlagManager(Set<QString> &files, const QString &filePath)
+                : m_files(files), m_filePath(filePath) { m_files.insert(m_filePath); }
+            ~ProcessingFlagManager() { m_files.remove(m_filePath); }
         private:
-            ASTCacheValue &m_cacheValue;
-        } processingFlagManager(cacheValue);
-        cacheValue.ast()->accept(&astVisitor);
+            Set<QString> &m_files;
+            const QString m_filePath;
+        } processingFlagManager(m_filesBeingProcessed, filePath);
+        parsedFile->ast->accept(&astVisitor);
     }
     astVisitor.checkItemTypes();
     return astVisitor.rootItem();
@@ -186,6 +147,12 @@ bool ItemReaderVisitorState::findDirectoryEntries(const QString &dirPath, QStrin
     return true;
 }
 
+void ItemReaderVisitorState::setASTCache(const ASTCachePtr &cache)
+{
+    QBS_CHECK(cache);
+    m_astCache = cache;
+}
+
 Item *ItemReaderVisitorState::mostDerivingItem() const
 {
     return m_mostDerivingItem;
@@ -196,6 +163,14 @@ void ItemReaderVisitorState::setMostDerivingItem(Item *item)
     m_mostDerivingItem = item;
 }
 
+// The same few property names appear in almost every item, so sharing their string data
+// saves memory. It is not an interned identifier type: the property maps still hash and
+// compare the names as strings.
+QString ItemReaderVisitorState::internedPropertyName(const QString &name)
+{
+    return *m_propertyNames.insert(name).first;
+}
+
 
 } // namespace Internal
 } // namespace qbs
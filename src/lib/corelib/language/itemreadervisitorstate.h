@@ -39,6 +39,8 @@
 #ifndef QBS_ITEMREADERVISITORSTATE_H
 #define QBS_ITEMREADERVISITORSTATE_H
 
+#include "forward_decls.h"
+
 #include <logging/logger.h>
 #include <tools/set.h>
 
@@ -59,20 +61,24 @@ public:
 
     Item *readFile(const QString &filePath, const QStringList &searchPaths, ItemPool *itemPool);
 
+    void setASTCache(const ASTCachePtr &cache);
+
     void cacheDirectoryEntries(const QString &dirPath, const QStringList &entries);
     bool findDirectoryEntries(const QString &dirPath, QStringList *entries) const;
 
     Item *mostDerivingItem() const;
     void setMostDerivingItem(Item *item);
 
+    QString internedPropertyName(const QString &name);
+
 private:
     Logger &m_logger;
     Set<QString> m_filesRead;
+    Set<QString> m_filesBeingProcessed;
+    ASTCachePtr m_astCache;
     QHash<QString, QStringList> m_directoryEntries;
+    Set<QString> m_propertyNames;
     Item *m_mostDerivingItem = nullptr;
-
-    class ASTCache;
-    ASTCache * const m_astCache;
 };
 
 } // namespace Internal
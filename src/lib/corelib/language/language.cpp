@@ -64,7 +64,7 @@
 
 #include <QtCore/qcryptographichash.h>
 #include <QtCore/qdir.h>
-#include <QtCore/qdiriterator.h>
+#include <QtCore/qfileinfo.h>
 #include <QtCore/qmap.h>
 
 #include <QtScript/qscriptvalue.h>
@@ -519,7 +519,6 @@ QString ResolvedProduct::cachedExecutablePath(const QString &origFilePath) const
     return m_executablePathCache.value(origFilePath);
 }
 
-
 ResolvedProject::ResolvedProject() : enabled(true), m_topLevelProject(nullptr)
 {
 }
@@ -648,11 +647,39 @@ void TopLevelProject::store(Logger logger)
     buildData->setClean();
 }
 
+// Most maps are shared between many groups and artifacts already, so each object is looked
+// up in the interner only once.
+void TopLevelProject::internPropertyMaps()
+{
+    QHash<const PropertyMapInternal *, PropertyMapPtr> internedMaps;
+    const auto intern = [this, &internedMaps](const PropertyMapPtr &map) {
+        PropertyMapPtr &internedMap = internedMaps[map.get()];
+        if (!internedMap)
+            internedMap = propertyMapInterner.intern(map);
+        return internedMap;
+    };
+    for (const ResolvedProductPtr &product : allProducts()) {
+        product->moduleProperties = intern(product->moduleProperties);
+        for (const GroupPtr &group : product->groups) {
+            group->properties = intern(group->properties);
+            for (const SourceArtifactPtr &artifact : group->allFiles())
+                artifact->properties = intern(artifact->properties);
+        }
+        for (const ArtifactPropertiesPtr &props : product->artifactProperties)
+            props->setPropertyMapInternal(intern(props->propertyMap()));
+        if (!product->buildData)
+            continue;
+        for (Artifact * const artifact : filterByType<Artifact>(product->buildData->allNodes()))
+            artifact->properties = intern(artifact->properties);
+    }
+}
+
 void TopLevelProject::load(PersistentPool &pool)
 {
     ResolvedProject::load(pool);
     serializationOp<PersistentPool::Load>(pool);
     QBS_CHECK(buildData);
+    internPropertyMaps();
 }
 
 void TopLevelProject::store(PersistentPool &pool)
@@ -694,8 +721,25 @@ void TopLevelProject::store(PersistentPool &pool)
 Set<QString> SourceWildCards::expandPatterns(const GroupConstPtr &group,
                                               const QString &baseDir, const QString &buildDir)
 {
+    // The listings from the last expansion are re-used for all directories whose timestamps
+    // have not changed since then. Listings of directories that are no longer visited get
+    // dropped.
+    m_previousDirListings = std::move(dirListings);
+    dirListings.clear();
+    dirTimeStamps.clear();
     Set<QString> files = expandPatterns(group, patterns, baseDir, buildDir);
     files -= expandPatterns(group, excludePatterns, baseDir, buildDir);
+    m_previousDirListings.clear();
+
+    // Only the entries that matched or were descended into can make a difference the next
+    // time, as the patterns stay the same.
+    for (auto &listing : dirListings) {
+        DirectoryListing::Entries &entries = listing.second.entries;
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [](const std::pair<QString, int> &entry) {
+            return !(entry.second & DirectoryListing::IsRelevant);
+        }), entries.end());
+    }
     return files;
 }
 
@@ -728,6 +772,13 @@ Set<QString> SourceWildCards::expandPatterns(const GroupConstPtr &group,
     return files;
 }
 
+static QString joinedPath(const QString &dirPath, const QString &fileName)
+{
+    return dirPath.endsWith(QLatin1Char('/')) ? dirPath + fileName
+                                              : dirPath + QLatin1Char('/') + fileName;
+}
+
+// The matching follows what QDirIterator does for the respective filters.
 void SourceWildCards::expandPatterns(Set<QString> &result, const GroupConstPtr &group,
                                      const QStringList &parts,
                                      const QString &baseDir, const QString &buildDir)
@@ -738,8 +789,6 @@ void SourceWildCards::expandPatterns(Set<QString> &result, const GroupConstPtr &
     if (baseDir.startsWith(buildDir))
         return;
 
-    dirTimeStamps.push_back({ baseDir, FileInfo(baseDir).lastModified() });
-
     QStringList changed_parts = parts;
     bool recursive = false;
     QString part = changed_parts.takeFirst();
@@ -758,35 +807,99 @@ void SourceWildCards::expandPatterns(Set<QString> &result, const GroupConstPtr &
     const bool isDir = !changed_parts.empty();
 
     const QString &filePattern = part;
-    const QDirIterator::IteratorFlags itFlags = recursive
-            ? QDirIterator::Subdirectories
-            : QDirIterator::NoIteratorFlags;
-    QDir::Filters itFilters = isDir
-            ? QDir::Dirs
-            : QDir::Files | QDir::System
-              | QDir::Dirs; // This one is needed to get symbolic links to directories
-
-    if (isDir && !FileInfo::isPattern(filePattern))
-        itFilters |= QDir::Hidden;
-    if (filePattern != StringConstants::dotDot() && filePattern != StringConstants::dot())
-        itFilters |= QDir::NoDotAndDotDot;
-
-    QDirIterator it(baseDir, QStringList(filePattern), itFilters, itFlags);
-    while (it.hasNext()) {
-        const QString filePath = it.next();
-        const QString parentDir = it.fileInfo().dir().path();
-        if (parentDir.startsWith(buildDir))
+    const QRegExp filePatternRegExp(filePattern, Qt::CaseInsensitive, QRegExp::Wildcard);
+    const bool includeHidden = isDir && !FileInfo::isPattern(filePattern);
+    const bool isDotOrDotDot = filePattern == StringConstants::dotDot()
+            || filePattern == StringConstants::dot();
+    using Listing = DirectoryListing;
+    const auto matches = [&](const QString &fileName, int flags) {
+        if (!filePatternRegExp.exactMatch(fileName))
+            return false;
+        if (!includeHidden && (flags & Listing::IsHidden))
+            return false;
+        if (!isDir)
+            return !(flags & Listing::IsDir) || (flags & Listing::IsSymLink);
+
+        // Only directories, and no "system" entries such as dangling symlinks.
+        return (flags & Listing::IsDir) && (flags & Listing::Exists);
+    };
+
+    QStringList dirPaths(baseDir);
+    while (!dirPaths.empty()) {
+        const QString dirPath = dirPaths.takeLast();
+        if (dirPath.startsWith(buildDir))
             continue; // See above.
-        if (!isDir && it.fileInfo().isDir() && !it.fileInfo().isSymLink())
-            continue;
-        if (isDir) {
-            expandPatterns(result, group, changed_parts, filePath, buildDir);
-        } else {
-            if (parentDir != baseDir)
-                dirTimeStamps.push_back({parentDir, FileInfo(baseDir).lastModified()});
-            result += QDir::cleanPath(filePath);
+        for (std::pair<QString, int> &entry : directoryEntries(dirPath)) {
+            const QString filePath = joinedPath(dirPath, entry.first);
+            const int flags = entry.second;
+            if (recursive && (flags & Listing::IsDir) && !(flags & Listing::IsSymLink)
+                    && (includeHidden || !(flags & Listing::IsHidden))) {
+                entry.second |= Listing::IsRelevant;
+                dirPaths << filePath;
+            }
+            if (!matches(entry.first, flags))
+                continue;
+            entry.second |= Listing::IsRelevant;
+            if (isDir)
+                expandPatterns(result, group, changed_parts, filePath, buildDir);
+            else
+                result += QDir::cleanPath(filePath);
+        }
+
+        // "." and ".." are not part of the listing, but they can be given explicitly as
+        // directory names.
+        if (isDir && isDotOrDotDot && FileInfo(dirPath).isDir()) {
+            expandPatterns(result, group, changed_parts, joinedPath(dirPath, filePattern),
+                           buildDir);
+        }
+    }
+}
+
+static int directoryEntryFlags(const QFileInfo &fi)
+{
+    int flags = 0;
+    if (fi.isDir())
+        flags |= SourceWildCards::DirectoryListing::IsDir;
+    if (fi.isFile())
+        flags |= SourceWildCards::DirectoryListing::IsFile;
+    if (fi.isSymLink())
+        flags |= SourceWildCards::DirectoryListing::IsSymLink;
+    if (fi.isHidden())
+        flags |= SourceWildCards::DirectoryListing::IsHidden;
+    if (fi.exists())
+        flags |= SourceWildCards::DirectoryListing::Exists;
+    return flags;
+}
+
+SourceWildCards::DirectoryListing::Entries &SourceWildCards::directoryEntries(
+        const QString &dirPath)
+{
+    const auto it = dirListings.find(dirPath);
+    if (it != dirListings.cend())
+        return it->second.entries;
+
+    DirectoryListing listing;
+    listing.timestamp = FileInfo(dirPath).lastModified();
+    dirTimeStamps.push_back({dirPath, listing.timestamp});
+    const auto previous = m_previousDirListings.find(dirPath);
+    if (previous != m_previousDirListings.cend()
+            && previous->second.timestamp == listing.timestamp) {
+        listing.entries = std::move(previous->second.entries);
+
+        // The target of a symlink can change without the directory being modified.
+        for (std::pair<QString, int> &entry : listing.entries) {
+            if (entry.second & DirectoryListing::IsSymLink)
+                entry.second = directoryEntryFlags(QFileInfo(joinedPath(dirPath, entry.first)));
         }
+    } else {
+        const QFileInfoList fileInfos = QDir(dirPath).entryInfoList(
+                    QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot,
+                    QDir::Unsorted);
+        listing.entries.reserve(fileInfos.size());
+        for (const QFileInfo &fi : fileInfos)
+            listing.entries.push_back({fi.fileName(), directoryEntryFlags(fi)});
     }
+    return dirListings.emplace(dirPath, std::move(listing)).first->second.entries;
 }
 
 template<typename L>
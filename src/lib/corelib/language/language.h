@@ -44,6 +44,7 @@
 #include "forward_decls.h"
 #include "jsimports.h"
 #include "propertydeclaration.h"
+#include "propertymapinternal.h"
 #include "resolvedfilecontext.h"
 
 #include <buildgraph/forward_decls.h>
@@ -51,6 +52,7 @@
 #include <tools/filetime.h>
 #include <tools/joblimits.h>
 #include <tools/persistence.h>
+#include <tools/qttools.h>
 #include <tools/set.h>
 #include <tools/weakpointer.h>
 
@@ -66,6 +68,8 @@
 
 #include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 QT_BEGIN_NAMESPACE
@@ -252,15 +256,37 @@ public:
     Set<QString> expandPatterns(const GroupConstPtr &group, const QString &baseDir,
                                  const QString &buildDir);
 
+    // The relevant entries of a directory that was looked at during the last expansion, so
+    // that a directory needs to be read again only if its timestamp has changed.
+    class DirectoryListing
+    {
+    public:
+        enum EntryFlag {
+            IsDir = 1, IsFile = 2, IsSymLink = 4, IsHidden = 8, Exists = 16, IsRelevant = 32
+        };
+        using Entries = std::vector<std::pair<QString, int>>;
+
+        FileTime timestamp;
+        Entries entries;
+
+        template<PersistentPool::OpType opType> void completeSerializationOp(PersistentPool &pool)
+        {
+            pool.serializationOp<opType>(timestamp, entries);
+        }
+    };
+
     const ResolvedGroup *group = nullptr;       // The owning group.
     QStringList patterns;
     QStringList excludePatterns;
     std::vector<std::pair<QString, FileTime>> dirTimeStamps;
+    std::unordered_map<QString, DirectoryListing> dirListings;
     std::vector<SourceArtifactPtr> files;
 
     template<PersistentPool::OpType opType> void completeSerializationOp(PersistentPool &pool)
     {
         pool.serializationOp<opType>(patterns, excludePatterns, dirTimeStamps, files);
+        if (pool.version() >= PersistentPool::MappedVersion)
+            pool.serializationOp<opType>(dirListings);
     }
 
 private:
@@ -269,6 +295,9 @@ private:
     void expandPatterns(Set<QString> &result, const GroupConstPtr &group,
                         const QStringList &parts, const QString &baseDir,
                         const QString &buildDir);
+    DirectoryListing::Entries &directoryEntries(const QString &dirPath);
+
+    std::unordered_map<QString, DirectoryListing> m_previousDirListings;
 };
 
 class QBS_AUTOTEST_EXPORT ResolvedGroup
@@ -688,7 +717,11 @@ public:
     static QString deriveId(const QVariantMap &config);
     static QString deriveBuildDirectory(const QString &buildRoot, const QString &id);
 
+    void internPropertyMaps();
+
     QString buildDirectory; // Not saved
+    PropertyMapInterner propertyMapInterner; // Not saved
+    ASTCachePtr astCache; // Not saved
     QProcessEnvironment environment;
     std::vector<ProbeConstPtr> probes;
 
@@ -2,6 +2,7 @@ include(../../../install_prefix.pri)
 
 HEADERS += \
     $$PWD/artifactproperties.h \
+    $$PWD/astcache.h \
     $$PWD/astimportshandler.h \
     $$PWD/astpropertiesitemhandler.h \
     $$PWD/asttools.h \
@@ -29,6 +30,7 @@ HEADERS += \
     $$PWD/moduleloader.h \
     $$PWD/modulemerger.h \
     $$PWD/preparescriptobserver.h \
+    $$PWD/probecache.h \
     $$PWD/projectresolver.h \
     $$PWD/property.h \
     $$PWD/propertydeclaration.h \
@@ -42,6 +44,7 @@ HEADERS += \
 
 SOURCES += \
     $$PWD/artifactproperties.cpp \
+    $$PWD/astcache.cpp \
     $$PWD/astimportshandler.cpp \
     $$PWD/astpropertiesitemhandler.cpp \
     $$PWD/asttools.cpp \
@@ -63,6 +66,7 @@ SOURCES += \
     $$PWD/moduleloader.cpp \
     $$PWD/modulemerger.cpp \
     $$PWD/preparescriptobserver.cpp \
+    $$PWD/probecache.cpp \
     $$PWD/scriptpropertyobserver.cpp \
     $$PWD/projectresolver.cpp \
     $$PWD/property.cpp \
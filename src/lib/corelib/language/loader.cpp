@@ -39,6 +39,7 @@
 
 #include "loader.h"
 
+#include "astcache.h"
 #include "evaluator.h"
 #include "language.h"
 #include "moduleloader.h"
@@ -160,11 +161,15 @@ TopLevelProjectPtr Loader::loadProject(const SetupProjectParameters &_parameters
     moduleLoader.setOldProductProbes(m_oldProductProbes);
     moduleLoader.setLastResolveTime(m_lastResolveTime);
     moduleLoader.setStoredProfiles(m_storedProfiles);
+    if (!m_astCache)
+        m_astCache = std::make_shared<ASTCache>();
+    moduleLoader.setASTCache(m_astCache);
     const ModuleLoaderResult loadResult = moduleLoader.load(parameters);
     ProjectResolver resolver(&evaluator, loadResult, parameters, m_logger);
     resolver.setProgressObserver(m_progressObserver);
     const TopLevelProjectPtr project = resolver.resolve();
     project->lastResolveTime = resolveTime;
+    project->astCache = m_astCache;
 
     // E.g. if the top-level project is disabled.
     if (m_progressObserver)
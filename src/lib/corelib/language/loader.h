@@ -63,6 +63,7 @@ public:
     void setOldProjectProbes(const std::vector<ProbeConstPtr> &oldProbes);
     void setOldProductProbes(const QHash<QString, std::vector<ProbeConstPtr>> &oldProbes);
     void setLastResolveTime(const FileTime &time) { m_lastResolveTime = time; }
+    void setASTCache(const ASTCachePtr &cache) { m_astCache = cache; }
     void setStoredProfiles(const QVariantMap &profiles);
     TopLevelProjectPtr loadProject(const SetupProjectParameters &parameters);
 
@@ -77,6 +78,7 @@ private:
     QHash<QString, std::vector<ProbeConstPtr>> m_oldProductProbes;
     QVariantMap m_storedProfiles;
     FileTime m_lastResolveTime;
+    ASTCachePtr m_astCache;
 };
 
 } // namespace Internal
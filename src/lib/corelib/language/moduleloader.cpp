@@ -42,21 +42,28 @@
 #include "builtindeclarations.h"
 #include "evaluator.h"
 #include "filecontext.h"
+#include "identifiersearch.h"
 #include "item.h"
 #include "itemreader.h"
 #include "language.h"
 #include "modulemerger.h"
+#include "probecache.h"
 #include "qualifiedid.h"
 #include "scriptengine.h"
 #include "value.h"
 
 #include <api/languageinfo.h>
+#include <buildgraph/buildgraph.h>
 #include <language/language.h>
 #include <logging/categories.h>
 #include <logging/logger.h>
 #include <logging/translator.h>
+#include <parser/qmljsengine_p.h>
+#include <parser/qmljslexer_p.h>
+#include <parser/qmljsparser_p.h>
 #include <tools/error.h>
 #include <tools/fileinfo.h>
+#include <tools/parallelfor.h>
 #include <tools/preferences.h>
 #include <tools/profile.h>
 #include <tools/profiling.h>
@@ -267,6 +274,11 @@ void ModuleLoader::setStoredProfiles(const QVariantMap &profiles)
     m_storedProfiles = profiles;
 }
 
+void ModuleLoader::setASTCache(const ASTCachePtr &cache)
+{
+    m_reader->setASTCache(cache);
+}
+
 ModuleLoaderResult ModuleLoader::load(const SetupProjectParameters &parameters)
 {
     TimedActivityLogger moduleLoaderTimer(m_logger, Tr::tr("ModuleLoader"),
@@ -275,6 +287,7 @@ ModuleLoaderResult ModuleLoader::load(const SetupProjectParameters &parameters)
     m_parameters = parameters;
     m_modulePrototypes.clear();
     m_modulePrototypeEnabledInfo.clear();
+    m_modulePrototypeStructures.clear();
     m_parameterDeclarations.clear();
     m_disabledItems.clear();
     m_reader->clearExtraSearchPathsStack();
@@ -285,6 +298,8 @@ ModuleLoaderResult ModuleLoader::load(const SetupProjectParameters &parameters)
     m_elapsedTimeProbes = 0;
     m_probesEncountered = m_probesRun = m_probesCachedCurrent = m_probesCachedOld = 0;
     m_settings.reset(new Settings(parameters.settingsDirectory()));
+    const QString probeCacheDir = Preferences(m_settings.get()).probeCacheDirectory();
+    m_probeCache.reset(probeCacheDir.isEmpty() ? nullptr : new ProbeCache(probeCacheDir, m_logger));
 
     for (const QString &key : m_parameters.overriddenValues().keys()) {
         static const QStringList prefixes({ StringConstants::projectPrefix(),
@@ -353,6 +368,8 @@ ModuleLoaderResult ModuleLoader::load(const SetupProjectParameters &parameters)
     result.qbsFiles = m_reader->filesRead();
     for (auto it = m_localProfiles.cbegin(); it != m_localProfiles.cend(); ++it)
         result.profileConfigs.remove(it.key());
+    if (m_probeCache)
+        m_probeCache->store();
     printProfilingInfo();
     return result;
 }
@@ -659,6 +676,7 @@ void ModuleLoader::handleProject(ModuleLoaderResult *loadResult,
     for (Item * const additionalProductItem : multiplexedProducts)
         Item::addChild(projectItem, additionalProductItem);
 
+    prefetchProbes(&dummyProductContext, {projectItem});
     resolveProbes(&dummyProductContext, projectItem);
     projectContext.topLevelProject->probes << dummyProductContext.info.probes;
 
@@ -1310,6 +1328,17 @@ void ModuleLoader::handleProduct(ModuleLoader::ProductContext *productContext)
     // set by the dependency module's merger (namely, scopes of defining items; see
     // ModuleMerger::replaceItemInScopes()).
     Item::Modules topSortedModules = modulesSortedByDependency(item);
+
+    // A module can only see the probe results of the modules it depends on, so the probes of
+    // all modules at the same depth in the dependency graph can be prefetched together.
+    QHash<QualifiedId, int> moduleDepths;
+    for (const Item::Module &module : topSortedModules) {
+        int depth = 0;
+        for (const Item::Module &dependency : module.item->modules())
+            depth = std::max(depth, moduleDepths.value(dependency.name) + 1);
+        moduleDepths.insert(module.name, depth);
+    }
+
     for (Item::Module &module : topSortedModules)
         ModuleMerger(m_logger, item, module).start();
 
@@ -1320,44 +1349,67 @@ void ModuleLoader::handleProduct(ModuleLoader::ProductContext *productContext)
     std::sort(lexicographicallySortedModules.begin(), lexicographicallySortedModules.end());
     item->setModules(lexicographicallySortedModules);
 
-    for (const Item::Module &module : topSortedModules) {
-        if (!module.item->isPresentModule())
-            continue;
-        try {
-            resolveProbes(productContext, module.item);
-            if (module.versionRange.minimum.isValid()
-                    || module.versionRange.maximum.isValid()) {
-                if (module.versionRange.maximum.isValid()
-                        && module.versionRange.minimum >= module.versionRange.maximum) {
-                    throw ErrorInfo(Tr::tr("Impossible version constraint [%1,%2) set for module "
-                                           "'%3'").arg(module.versionRange.minimum.toString(),
-                                                       module.versionRange.maximum.toString(),
-                                                       module.name.toString()));
-                }
-                const Version moduleVersion = Version::fromString(
-                            m_evaluator->stringValue(module.item,
-                                                     StringConstants::versionProperty()));
-                if (moduleVersion < module.versionRange.minimum) {
-                    throw ErrorInfo(Tr::tr("Module '%1' has version %2, but it needs to be "
-                            "at least %3.").arg(module.name.toString(),
-                                                moduleVersion.toString(),
-                                                module.versionRange.minimum.toString()));
-                }
-                if (module.versionRange.maximum.isValid()
-                        && moduleVersion >= module.versionRange.maximum) {
-                    throw ErrorInfo(Tr::tr("Module '%1' has version %2, but it needs to be "
-                            "lower than %3.").arg(module.name.toString(),
-                                               moduleVersion.toString(),
-                                               module.versionRange.maximum.toString()));
+    Item::Modules modulesByDepth = topSortedModules;
+    std::stable_sort(modulesByDepth.begin(), modulesByDepth.end(),
+                     [&moduleDepths](const Item::Module &m1, const Item::Module &m2) {
+        return moduleDepths.value(m1.name) < moduleDepths.value(m2.name);
+    });
+    for (auto waveBegin = modulesByDepth.cbegin(); waveBegin != modulesByDepth.cend();) {
+        const int depth = moduleDepths.value(waveBegin->name);
+        const auto waveEnd = std::find_if(waveBegin, modulesByDepth.cend(),
+                                          [&moduleDepths, depth](const Item::Module &m) {
+            return moduleDepths.value(m.name) != depth;
+        });
+        std::vector<Item *> probeParents;
+        for (auto it = waveBegin; it != waveEnd; ++it) {
+            if (it->item->isPresentModule())
+                probeParents.push_back(it->item);
+        }
+        prefetchProbes(productContext, probeParents);
+
+        for (auto it = waveBegin; it != waveEnd; ++it) {
+            const Item::Module &module = *it;
+            if (!module.item->isPresentModule())
+                continue;
+            try {
+                resolveProbes(productContext, module.item);
+                if (module.versionRange.minimum.isValid()
+                        || module.versionRange.maximum.isValid()) {
+                    if (module.versionRange.maximum.isValid()
+                            && module.versionRange.minimum >= module.versionRange.maximum) {
+                        throw ErrorInfo(Tr::tr("Impossible version constraint [%1,%2) set "
+                                               "for module '%3'").arg(
+                                            module.versionRange.minimum.toString(),
+                                            module.versionRange.maximum.toString(),
+                                            module.name.toString()));
+                    }
+                    const Version moduleVersion = Version::fromString(
+                                m_evaluator->stringValue(module.item,
+                                                         StringConstants::versionProperty()));
+                    if (moduleVersion < module.versionRange.minimum) {
+                        throw ErrorInfo(Tr::tr("Module '%1' has version %2, but it needs to be "
+                                "at least %3.").arg(module.name.toString(),
+                                                    moduleVersion.toString(),
+                                                    module.versionRange.minimum.toString()));
+                    }
+                    if (module.versionRange.maximum.isValid()
+                            && moduleVersion >= module.versionRange.maximum) {
+                        throw ErrorInfo(Tr::tr("Module '%1' has version %2, but it needs to be "
+                                "lower than %3.").arg(module.name.toString(),
+                                                   moduleVersion.toString(),
+                                                   module.versionRange.maximum.toString()));
+                    }
                 }
+            } catch (const ErrorInfo &error) {
+                handleModuleSetupError(productContext, module, error);
+                if (productContext->info.delayedError.hasError())
+                    return;
             }
-        } catch (const ErrorInfo &error) {
-            handleModuleSetupError(productContext, module, error);
-            if (productContext->info.delayedError.hasError())
-                return;
         }
+        waveBegin = waveEnd;
     }
 
+    prefetchProbes(productContext, {item});
     resolveProbes(productContext, item);
 
     // Module validation must happen in an extra pass, after all Probes have been resolved.
@@ -1774,6 +1826,37 @@ ProbeConstPtr ModuleLoader::findCurrentProbe(
     return ProbeConstPtr();
 }
 
+ProbeConstPtr ModuleLoader::findReusableProbe(const ProductContext *productContext,
+        const Item *parent, const Item *probe, const QString &probeId, bool condition,
+        const QVariantMap &initialProperties, const QString &sourceCode,
+        ProbeOrigin *origin) const
+{
+    ProbeConstPtr resolvedProbe;
+    if (parent->type() == ItemType::Project
+            || productContext->name.startsWith(shadowProductPrefix())) {
+        resolvedProbe = findOldProjectProbe(probeId, condition, initialProperties, sourceCode);
+    } else {
+        const QString &uniqueProductName = productContext->uniqueName();
+        resolvedProbe
+                = findOldProductProbe(uniqueProductName, condition, initialProperties, sourceCode);
+    }
+    if (resolvedProbe) {
+        *origin = ProbeOrigin::OldBuildGraph;
+        return resolvedProbe;
+    }
+    resolvedProbe = findCurrentProbe(probe->location(), condition, initialProperties);
+    if (resolvedProbe) {
+        *origin = ProbeOrigin::CurrentRun;
+        return resolvedProbe;
+    }
+    if (m_probeCache && !m_parameters.forceProbeExecution()) {
+        resolvedProbe = m_probeCache->find(probeId, condition, initialProperties, sourceCode,
+                                           m_evaluator->engine()->environment());
+        *origin = ProbeOrigin::ProbeCache;
+    }
+    return resolvedProbe;
+}
+
 bool ModuleLoader::probeMatches(const ProbeConstPtr &probe, bool condition,
         const QVariantMap &initialProperties, const QString &configureScript,
         CompareScript compareScript) const
@@ -3247,6 +3330,19 @@ static std::vector<std::pair<QualifiedId, ItemValuePtr>> instanceItemProperties(
     return result;
 }
 
+const ModuleLoader::ModulePrototypeStructure &ModuleLoader::modulePrototypeStructure(
+        Item *modulePrototype)
+{
+    const auto it = m_modulePrototypeStructures.find(modulePrototype);
+    if (it != m_modulePrototypeStructures.end())
+        return it->second;
+    ModulePrototypeStructure &structure = m_modulePrototypeStructures[modulePrototype];
+    structure.itemProperties = instanceItemProperties(modulePrototype);
+    if (modulePrototype->file()->idScope())
+        structure.itemsWithId = collectItemsWithId(modulePrototype);
+    return structure;
+}
+
 void ModuleLoader::instantiateModule(ProductContext *productContext, Item *exportingProduct,
         Item *instanceScope, Item *moduleInstance, Item *modulePrototype,
         const QualifiedId &moduleName, ProductModuleInfo *productModuleInfo)
@@ -3310,25 +3406,27 @@ void ModuleLoader::instantiateModule(ProductContext *productContext, Item *expor
     }
     moduleInstance->setScope(moduleScope);
 
+    const ModulePrototypeStructure &prototypeStructure = modulePrototypeStructure(modulePrototype);
     QHash<Item *, Item *> prototypeInstanceMap;
-    prototypeInstanceMap[modulePrototype] = moduleInstance;
+    const bool needPrototypeInstanceMap = !prototypeStructure.itemsWithId.empty();
+    if (needPrototypeInstanceMap)
+        prototypeInstanceMap[modulePrototype] = moduleInstance;
 
     // create instances for every child of the prototype
-    createChildInstances(moduleInstance, modulePrototype, &prototypeInstanceMap);
+    createChildInstances(moduleInstance, modulePrototype,
+                         needPrototypeInstanceMap ? &prototypeInstanceMap : nullptr);
 
     // create ids from from the prototype in the instance
-    if (modulePrototype->file()->idScope()) {
-        for (Item * const itemWithId : collectItemsWithId(modulePrototype)) {
-            Item *idProto = itemWithId;
-            Item *idInstance = prototypeInstanceMap.value(idProto);
-            QBS_ASSERT(idInstance, continue);
-            ItemValuePtr idInstanceValue = ItemValue::create(idInstance);
-            moduleScope->setProperty(itemWithId->id(), idInstanceValue);
-        }
+    for (Item * const itemWithId : prototypeStructure.itemsWithId) {
+        Item *idProto = itemWithId;
+        Item *idInstance = prototypeInstanceMap.value(idProto);
+        QBS_ASSERT(idInstance, continue);
+        ItemValuePtr idInstanceValue = ItemValue::create(idInstance);
+        moduleScope->setProperty(itemWithId->id(), idInstanceValue);
     }
 
     // For foo.bar in modulePrototype create an item foo in moduleInstance.
-    for (auto iip : instanceItemProperties(modulePrototype)) {
+    for (const auto &iip : prototypeStructure.itemProperties) {
         if (iip.second->item()->properties().empty())
             continue;
         qCDebug(lcModuleLoader) << "The prototype of " << moduleName
@@ -3374,7 +3472,8 @@ void ModuleLoader::createChildInstances(Item *instance, Item *prototype,
 
     for (Item * const childPrototype : prototype->children()) {
         Item *childInstance = Item::create(m_pool, childPrototype->type());
-        prototypeInstanceMap->insert(childPrototype, childInstance);
+        if (prototypeInstanceMap)
+            prototypeInstanceMap->insert(childPrototype, childInstance);
         childInstance->setPrototype(childPrototype);
         childInstance->setFile(childPrototype->file());
         childInstance->setId(childPrototype->id());
@@ -3385,6 +3484,216 @@ void ModuleLoader::createChildInstances(Item *instance, Item *prototype,
     }
 }
 
+class ModuleLoader::PrefetchedProbe
+{
+public:
+    void run(Logger &logger, const QProcessEnvironment &environment);
+
+    FileContextConstPtr file;
+    QString configureScript;
+    QVariantMap initialProperties;
+
+    bool success = false;
+    QVariantMap properties;
+    std::vector<QString> importedFilesUsed;
+    std::unique_ptr<ProbeQueries> queries;
+};
+
+// Runs the configure script in a script engine of its own, so it must not touch any items.
+void ModuleLoader::PrefetchedProbe::run(Logger &logger, const QProcessEnvironment &environment)
+{
+    const std::unique_ptr<ScriptEngine> engine(
+                ScriptEngine::create(logger, EvalContext::ProbeExecution));
+    engine->setEnvironment(environment);
+    engine->startRecordingProbeQueries();
+    QScriptValue fileScope = engine->newObject();
+    fileScope.setProperty(StringConstants::filePathGlobalVar(), file->filePath());
+    fileScope.setProperty(StringConstants::pathGlobalVar(), file->dirPath());
+    QScriptValue importScope = engine->newObject();
+    try {
+        setupScriptEngineForFile(engine.get(), file, importScope, ObserveMode::Enabled);
+    } catch (const ErrorInfo &) {
+        return;
+    }
+    QScriptValue configureScope = engine->newObject();
+    for (auto it = initialProperties.cbegin(); it != initialProperties.cend(); ++it)
+        configureScope.setProperty(it.key(), engine->toScriptValue(it.value()));
+    configureScope.setProperty(StringConstants::conditionProperty(), true);
+    engine->currentContext()->pushScope(fileScope);
+    engine->currentContext()->pushScope(importScope);
+    engine->currentContext()->pushScope(configureScope);
+    const QScriptValue sv = engine->evaluate(configureScript);
+    engine->currentContext()->popScope();
+    engine->currentContext()->popScope();
+    engine->currentContext()->popScope();
+    if (!engine->hasErrorOrException(sv)) {
+        for (auto it = initialProperties.cbegin(); it != initialProperties.cend(); ++it)
+            properties.insert(it.key(), configureScope.property(it.key()).toVariant());
+        properties.insert(StringConstants::conditionProperty(),
+                          configureScope.property(StringConstants::conditionProperty())
+                          .toVariant());
+        importedFilesUsed = engine->importedFilesUsedInScript();
+        success = true;
+    }
+    queries = engine->takeProbeQueries();
+    engine->releaseResourcesOfScriptObjects();
+}
+
+// Only plain values can be handed to a different script engine.
+static bool isTransferableProbeValue(const QScriptValue &value)
+{
+    if (value.isBool() || value.isNumber() || value.isString() || value.isUndefined())
+        return true;
+    if (!value.isArray())
+        return false;
+    const quint32 length = value.property(StringConstants::lengthProperty()).toUInt32();
+    for (quint32 i = 0; i < length; ++i) {
+        if (!isTransferableProbeValue(value.property(i)))
+            return false;
+    }
+    return true;
+}
+
+// Returns whether the given code refers to one of the given ids. Code that cannot be parsed
+// is assumed to do so.
+static bool refersToIds(const QString &code, const QStringList &ids)
+{
+    if (ids.empty())
+        return false;
+    QbsQmlJS::Engine engine;
+    QbsQmlJS::Lexer lexer(&engine);
+    lexer.setCode(code, 1, false);
+    QbsQmlJS::Parser parser(&engine);
+    if (!parser.parseProgram())
+        return true;
+    const std::unique_ptr<bool[]> found(new bool[ids.size()]);
+    IdentifierSearch search;
+    for (int i = 0; i < ids.size(); ++i)
+        search.add(ids.at(i), &found[i]);
+    search.start(parser.rootNode());
+    return std::any_of(found.get(), found.get() + ids.size(), [](bool f) { return f; });
+}
+
+static bool bindingsReferToIds(const Item *item, const QStringList &ids)
+{
+    const Item::PropertyMap &props = item->properties();
+    for (auto it = props.cbegin(); it != props.cend(); ++it) {
+        if (it.value()->type() != Value::JSSourceValueType)
+            continue;
+        const auto value = std::static_pointer_cast<const JSSourceValue>(it.value());
+        if (refersToIds(value->sourceCodeForEvaluation(), ids))
+            return true;
+        for (const JSSourceValue::Alternative &alternative : value->alternatives()) {
+            if (refersToIds(alternative.value->sourceCodeForEvaluation(), ids))
+                return true;
+        }
+    }
+    return false;
+}
+
+// Starts the configure scripts of the probes in the given items in parallel. The callers pass
+// only items whose probes cannot see each other's results, and probes that depend on an earlier
+// probe of the same item are left out, so resolveProbe() normally takes over every result.
+// Should the input properties differ nonetheless, the probe is run again the usual way.
+void ModuleLoader::prefetchProbes(ProductContext *productContext,
+                                  const std::vector<Item *> &parents)
+{
+    m_prefetchedProbes.clear();
+    if (!m_parameters.concurrentProbeExecution())
+        return;
+    AccumulatingTimer probesTimer(m_parameters.logElapsedTime() ? &m_elapsedTimeProbes : nullptr);
+    EvalContextSwitcher evalContextSwitcher(m_evaluator->engine(), EvalContext::ProbeExecution);
+    std::vector<PrefetchedProbe *> probes;
+    for (Item * const parent : parents) {
+        QStringList probeIds;
+        for (Item * const child : parent->children()) {
+            if (child->type() == ItemType::Probe && !child->id().isEmpty())
+                probeIds << child->id();
+        }
+
+        // The inputs of a probe see the results of the probes before it in the same item,
+        // either directly or via the item's own properties. Such probes cannot be prefetched.
+        const bool parentUsesProbeIds = probeIds.size() > 1
+                && bindingsReferToIds(parent, probeIds);
+        QStringList earlierProbeIds;
+        for (Item * const probe : parent->children()) {
+            if (probe->type() != ItemType::Probe)
+                continue;
+            const QStringList precedingProbeIds = earlierProbeIds;
+            if (!probe->id().isEmpty())
+                earlierProbeIds << probe->id();
+            if (!precedingProbeIds.empty()
+                    && (parentUsesProbeIds || bindingsReferToIds(probe, precedingProbeIds))) {
+                continue;
+            }
+            try {
+                const QString &probeId = probeGlobalId(probe);
+                const JSSourceValueConstPtr configureScript
+                        = probe->sourceProperty(StringConstants::configureProperty());
+                if (probeId.isEmpty() || !configureScript || configureScript->sourceCode()
+                        == StringConstants::undefinedValue()) {
+                    continue;
+                }
+                if (!m_evaluator->boolValue(probe, StringConstants::conditionProperty()))
+                    continue;
+                QVariantMap initialProperties;
+                bool transferable = true;
+                for (Item *obj = probe; obj && transferable; obj = obj->prototype()) {
+                    const Item::PropertyMap &props = obj->properties();
+                    for (auto it = props.cbegin(); it != props.cend(); ++it) {
+                        const QString &name = it.key();
+                        if (name == StringConstants::configureProperty()
+                                || name == StringConstants::conditionProperty()) {
+                            continue;
+                        }
+                        const QScriptValue value = m_evaluator->value(probe, name);
+                        if (!isTransferableProbeValue(value)) {
+                            transferable = false;
+                            break;
+                        }
+                        initialProperties.insert(name, value.toVariant());
+                    }
+                }
+                if (!transferable)
+                    continue;
+                const QString &sourceCode = configureScript->sourceCode().toString();
+                ProbeOrigin origin;
+                if (findReusableProbe(productContext, parent, probe, probeId, true,
+                                      initialProperties, sourceCode, &origin)) {
+                    continue;
+                }
+
+                // Ids of other items are not available in the worker's script engine.
+                const FileContextConstPtr file = configureScript->file();
+                const QString configureCode = configureScript->sourceCodeForEvaluation();
+                if (file->idScope()
+                        && refersToIds(configureCode, file->idScope()->properties().keys())) {
+                    continue;
+                }
+
+                const auto prefetchedProbe = new PrefetchedProbe;
+                prefetchedProbe->file = file;
+                prefetchedProbe->configureScript = configureCode;
+                prefetchedProbe->initialProperties = initialProperties;
+                m_prefetchedProbes[probe].reset(prefetchedProbe);
+                probes.push_back(prefetchedProbe);
+            } catch (const ErrorInfo &) {
+                // The probe gets resolved the usual way, which reports the error if it persists.
+            }
+        }
+    }
+    if (probes.size() < 2) {
+        m_prefetchedProbes.clear();
+        return;
+    }
+
+    qCDebug(lcModuleLoader) << "running" << probes.size() << "configure scripts concurrently";
+    const QProcessEnvironment environment = m_evaluator->engine()->environment();
+    parallelFor(probes.size(), [this, &probes, &environment](std::size_t i) {
+        probes.at(i)->run(m_logger, environment);
+    });
+}
+
 void ModuleLoader::resolveProbes(ProductContext *productContext, Item *item)
 {
     AccumulatingTimer probesTimer(m_parameters.logElapsedTime() ? &m_elapsedTimeProbes : nullptr);
@@ -3425,28 +3734,51 @@ void ModuleLoader::resolveProbe(ProductContext *productContext, Item *parent, It
     QScriptValue configureScope;
     const bool condition = m_evaluator->boolValue(probe, StringConstants::conditionProperty());
     const QString &sourceCode = configureScript->sourceCode().toString();
-    ProbeConstPtr resolvedProbe;
-    if (parent->type() == ItemType::Project
-            || productContext->name.startsWith(shadowProductPrefix())) {
-        resolvedProbe = findOldProjectProbe(probeId, condition, initialProperties, sourceCode);
-    } else {
-        const QString &uniqueProductName = productContext->uniqueName();
-        resolvedProbe
-                = findOldProductProbe(uniqueProductName, condition, initialProperties, sourceCode);
-    }
-    if (!resolvedProbe) {
-        resolvedProbe = findCurrentProbe(probe->location(), condition, initialProperties);
-        if (resolvedProbe) {
+    ProbeOrigin origin;
+    ProbeConstPtr resolvedProbe = findReusableProbe(productContext, parent, probe, probeId,
+                                                    condition, initialProperties, sourceCode,
+                                                    &origin);
+    if (resolvedProbe) {
+        switch (origin) {
+        case ProbeOrigin::OldBuildGraph:
+            qCDebug(lcModuleLoader) << "probe results cached from earlier run";
+            ++m_probesCachedOld;
+            break;
+        case ProbeOrigin::CurrentRun:
             qCDebug(lcModuleLoader) << "probe results cached from current run";
             ++m_probesCachedCurrent;
+            break;
+        case ProbeOrigin::ProbeCache:
+            qCDebug(lcModuleLoader) << "probe results cached from other project";
+            ++m_probesCachedOld;
+            break;
         }
-    } else {
-        qCDebug(lcModuleLoader) << "probe results cached from earlier run";
-        ++m_probesCachedOld;
     }
     std::vector<QString> importedFilesUsedInConfigure;
+    std::unique_ptr<ProbeQueries> probeQueries;
+    std::unique_ptr<PrefetchedProbe> prefetchedProbe;
+    if (condition && !resolvedProbe) {
+        const auto it = m_prefetchedProbes.find(probe);
+        if (it != m_prefetchedProbes.end()) {
+            // The probe's input might have been changed by the probes resolved before it.
+            if (it->second->success && it->second->initialProperties == initialProperties)
+                prefetchedProbe = std::move(it->second);
+            m_prefetchedProbes.erase(it);
+        }
+    }
     if (!condition) {
         qCDebug(lcModuleLoader) << "Probe disabled; skipping";
+    } else if (prefetchedProbe) {
+        ++m_probesRun;
+        qCDebug(lcModuleLoader) << "configure script was run concurrently";
+        configureScope = engine->newObject();
+        for (const ProbeProperty &b : qAsConst(probeBindings)) {
+            configureScope.setProperty(b.first,
+                    engine->toScriptValue(prefetchedProbe->properties.value(b.first)));
+        }
+        importedFilesUsedInConfigure = prefetchedProbe->importedFilesUsed;
+        probeQueries = std::move(prefetchedProbe->queries);
+        engine->addProbeQueryResults(*probeQueries);
     } else if (!resolvedProbe) {
         ++m_probesRun;
         qCDebug(lcModuleLoader) << "configure script needs to run";
@@ -3459,7 +3791,10 @@ void ModuleLoader::resolveProbe(ProductContext *productContext, Item *parent, It
             configureScope.setProperty(b.first, b.second);
         engine->currentContext()->pushScope(configureScope);
         engine->clearRequestedProperties();
+        if (m_probeCache)
+            engine->startRecordingProbeQueries();
         QScriptValue sv = engine->evaluate(configureScript->sourceCodeForEvaluation());
+        probeQueries = engine->takeProbeQueries();
         engine->currentContext()->popScope();
         engine->currentContext()->popScope();
         engine->currentContext()->popScope();
@@ -3497,6 +3832,8 @@ void ModuleLoader::resolveProbe(ProductContext *productContext, Item *parent, It
                                       sourceCode, properties, initialProperties,
                                       importedFilesUsedInConfigure);
         m_currentProbes[probe->location()] << resolvedProbe;
+        if (m_probeCache && probeQueries)
+            m_probeCache->insert(resolvedProbe, *probeQueries);
     }
     productContext->info.probes << resolvedProbe;
 }
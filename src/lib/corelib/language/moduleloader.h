@@ -71,6 +71,7 @@ namespace Internal {
 class Evaluator;
 class Item;
 class ItemReader;
+class ProbeCache;
 class ProgressObserver;
 class QualifiedId;
 
@@ -128,6 +129,7 @@ public:
     void setOldProductProbes(const QHash<QString, std::vector<ProbeConstPtr>> &oldProbes);
     void setLastResolveTime(const FileTime &time) { m_lastResolveTime = time; }
     void setStoredProfiles(const QVariantMap &profiles);
+    void setASTCache(const ASTCachePtr &cache);
     Evaluator *evaluator() const { return m_evaluator; }
 
     ModuleLoaderResult load(const SetupProjectParameters &parameters);
@@ -320,6 +322,14 @@ private:
             const QualifiedId &moduleName, ProductModuleInfo *productModuleInfo);
     void createChildInstances(Item *instance, Item *prototype,
                               QHash<Item *, Item *> *prototypeInstanceMap) const;
+
+    struct ModulePrototypeStructure
+    {
+        std::vector<std::pair<QualifiedId, ItemValuePtr>> itemProperties;
+        QList<Item *> itemsWithId;
+    };
+    const ModulePrototypeStructure &modulePrototypeStructure(Item *modulePrototype);
+    void prefetchProbes(ProductContext *productContext, const std::vector<Item *> &parents);
     void resolveProbes(ProductContext *productContext, Item *item);
     void resolveProbe(ProductContext *productContext, Item *parent, Item *probe);
     void checkCancelation() const;
@@ -349,6 +359,11 @@ private:
                                       const QString &sourceCode) const;
     ProbeConstPtr findCurrentProbe(const CodeLocation &location, bool condition,
                                    const QVariantMap &initialProperties) const;
+    enum class ProbeOrigin { OldBuildGraph, CurrentRun, ProbeCache };
+    ProbeConstPtr findReusableProbe(const ProductContext *productContext, const Item *parent,
+                                    const Item *probe, const QString &probeId, bool condition,
+                                    const QVariantMap &initialProperties,
+                                    const QString &sourceCode, ProbeOrigin *origin) const;
 
     enum class CompareScript { No, Yes };
     bool probeMatches(const ProbeConstPtr &probe, bool condition,
@@ -395,6 +410,11 @@ private:
     // condition is true for that product.
     QHash<std::pair<Item *, ProductContext *>, bool> m_modulePrototypeEnabledInfo;
 
+    // Module instances look up their properties in the prototype and only store the values
+    // overridden by the product, so the prototype's structure is all that instantiation needs
+    // from it. We compute it once per prototype instead of for every product.
+    std::unordered_map<const Item *, ModulePrototypeStructure> m_modulePrototypeStructures;
+
     QHash<const Item *, Item::PropertyDeclarationMap> m_parameterDeclarations;
     Set<Item *> m_disabledItems;
     std::vector<bool> m_requiredChain;
@@ -417,6 +437,8 @@ private:
     QHash<QString, std::vector<ProbeConstPtr>> m_oldProductProbes;
     FileTime m_lastResolveTime;
     QHash<CodeLocation, QList<ProbeConstPtr>> m_currentProbes;
+    class PrefetchedProbe;
+    std::unordered_map<const Item *, std::unique_ptr<PrefetchedProbe>> m_prefetchedProbes;
     QVariantMap m_storedProfiles;
     QVariantMap m_localProfiles;
     std::multimap<QString, const ProductContext *> m_productsByName;
@@ -427,6 +449,7 @@ private:
 
     SetupProjectParameters m_parameters;
     std::unique_ptr<Settings> m_settings;
+    std::unique_ptr<ProbeCache> m_probeCache;
     Version m_qbsVersion;
     Item *m_tempScopeItem = nullptr;
 
@@ -0,0 +1,203 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "probecache.h"
+
+#include "language.h"
+
+#include <logging/categories.h>
+#include <logging/translator.h>
+#include <tools/error.h>
+#include <tools/fileinfo.h>
+
+#include <QtCore/qdir.h>
+#include <QtCore/qlockfile.h>
+
+#include <algorithm>
+
+namespace qbs {
+namespace Internal {
+
+// The number of results kept per probe, e.g. for different toolchains or profiles.
+static const std::size_t maxEntriesPerProbe = 8;
+
+ProbeCache::ProbeCache(const QString &directory, Logger &logger)
+    : m_filePath(directory + QLatin1String("/probes.cache")), m_logger(logger)
+{
+}
+
+ProbeConstPtr ProbeCache::find(const QString &globalId, bool condition,
+                               const QVariantMap &initialProperties,
+                               const QString &configureScript,
+                               const QProcessEnvironment &environment)
+{
+    load();
+    const auto it = m_entries.constFind(globalId);
+    if (it == m_entries.constEnd())
+        return ProbeConstPtr();
+    for (const Entry &entry : it.value()) {
+        if (entry.probe->condition() == condition
+                && entry.probe->initialProperties() == initialProperties
+                && entry.probe->configureScript() == configureScript
+                && isUpToDate(entry, environment)) {
+            return entry.probe;
+        }
+    }
+    return ProbeConstPtr();
+}
+
+void ProbeCache::insert(const ProbeConstPtr &probe, const ProbeQueries &queries)
+{
+    // If the result depends on all environment variables, we cannot tell whether it is
+    // still valid in a different context.
+    if (queries.usesWholeEnvironment)
+        return;
+    load();
+    Entry entry;
+    entry.probe = probe;
+    entry.queries = queries;
+    entry.creationTime = FileTime::currentTime();
+    addEntry(m_entries, entry);
+    m_newEntries.push_back(entry);
+}
+
+void ProbeCache::store()
+{
+    if (m_newEntries.empty())
+        return;
+
+    // Other qbs processes share the file. The lock makes sure that the entries they have stored
+    // since we loaded the cache are not lost; readers do not need it, because the file
+    // gets replaced atomically.
+    QLockFile lockFile(m_filePath + QLatin1String(".lock"));
+    if (!lockFile.tryLock(10000)) {
+        m_logger.printWarning(ErrorInfo(Tr::tr("Failed to store probe cache: "
+                                               "Cannot lock file '%1'.")
+                                        .arg(lockFile.fileName())));
+        return;
+    }
+    try {
+        QHash<QString, std::vector<Entry>> entries = readEntries();
+        for (const Entry &entry : m_newEntries)
+            addEntry(entries, entry);
+        PersistentPool pool(m_logger);
+        pool.setupWriteStream(m_filePath);
+        pool.store(entries);
+        pool.finalizeWriteStream();
+        m_entries = entries;
+        m_newEntries.clear();
+    } catch (const ErrorInfo &e) {
+        m_logger.printWarning(ErrorInfo(Tr::tr("Failed to store probe cache: %1")
+                                        .arg(e.toString())));
+    }
+}
+
+void ProbeCache::load()
+{
+    if (m_loaded)
+        return;
+    m_loaded = true;
+    m_entries = readEntries();
+}
+
+QHash<QString, std::vector<ProbeCache::Entry>> ProbeCache::readEntries()
+{
+    QHash<QString, std::vector<Entry>> entries;
+    if (!FileInfo::exists(m_filePath))
+        return entries;
+    try {
+        PersistentPool pool(m_logger);
+        pool.load(m_filePath);
+        pool.load(entries);
+    } catch (const ErrorInfo &e) {
+        // The cache might have been written by a different version of qbs. It gets
+        // overwritten on the next store operation.
+        qCDebug(lcModuleLoader) << "cannot use probe cache:" << e.toString();
+        entries.clear();
+    }
+    return entries;
+}
+
+void ProbeCache::addEntry(QHash<QString, std::vector<Entry>> &entries, const Entry &entry)
+{
+    const ProbeConstPtr &probe = entry.probe;
+    std::vector<Entry> &probeEntries = entries[probe->globalId()];
+    probeEntries.erase(std::remove_if(probeEntries.begin(), probeEntries.end(),
+                                      [&probe](const Entry &e) {
+        return e.probe->condition() == probe->condition()
+                && e.probe->initialProperties() == probe->initialProperties()
+                && e.probe->configureScript() == probe->configureScript();
+    }), probeEntries.end());
+    if (probeEntries.size() >= maxEntriesPerProbe)
+        probeEntries.erase(probeEntries.begin());
+    probeEntries.push_back(entry);
+}
+
+bool ProbeCache::isUpToDate(const Entry &entry, const QProcessEnvironment &environment)
+{
+    if (entry.probe->needsReconfigure(entry.creationTime))
+        return false;
+    const ProbeQueries &queries = entry.queries;
+    for (auto it = queries.fileExistsResults.cbegin(); it != queries.fileExistsResults.cend();
+         ++it) {
+        if (FileInfo(it.key()).exists() != it.value())
+            return false;
+    }
+    for (auto it = queries.directoryEntriesResults.cbegin();
+         it != queries.directoryEntriesResults.cend(); ++it) {
+        if (QDir(it.key().first).entryList(static_cast<QDir::Filters>(it.key().second),
+                                           QDir::Name) != it.value()) {
+            return false;
+        }
+    }
+    for (auto it = queries.fileLastModifiedResults.cbegin();
+         it != queries.fileLastModifiedResults.cend(); ++it) {
+        if (FileInfo(it.key()).lastModified() != it.value())
+            return false;
+    }
+    for (auto it = queries.environmentValues.cbegin(); it != queries.environmentValues.cend();
+         ++it) {
+        if (environment.value(it.key()) != it.value())
+            return false;
+    }
+    return true;
+}
+
+} // namespace Internal
+} // namespace qbs
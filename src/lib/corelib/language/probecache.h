@@ -0,0 +1,120 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QBS_PROBECACHE_H
+#define QBS_PROBECACHE_H
+
+#include "forward_decls.h"
+
+#include <logging/logger.h>
+#include <tools/filetime.h>
+#include <tools/persistence.h>
+
+#include <QtCore/qhash.h>
+#include <QtCore/qprocess.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qvariant.h>
+
+#include <utility>
+#include <vector>
+
+namespace qbs {
+namespace Internal {
+
+// The file system and environment queries done by a probe's configure script.
+class ProbeQueries
+{
+public:
+    QHash<QString, bool> fileExistsResults;
+    QHash<std::pair<QString, quint32>, QStringList> directoryEntriesResults;
+    QHash<QString, FileTime> fileLastModifiedResults;
+    QHash<QString, QString> environmentValues;
+    bool usesWholeEnvironment = false;
+
+    template<PersistentPool::OpType opType> void completeSerializationOp(PersistentPool &pool)
+    {
+        pool.serializationOp<opType>(fileExistsResults, directoryEntriesResults,
+                                     fileLastModifiedResults, environmentValues);
+    }
+};
+
+// Keeps probe results across projects and build directories. An entry is used if the probe's
+// configure script and initial properties are the same and none of the queries the script did
+// when it ran would give a different result now.
+class ProbeCache
+{
+public:
+    ProbeCache(const QString &directory, Logger &logger);
+
+    ProbeConstPtr find(const QString &globalId, bool condition,
+                       const QVariantMap &initialProperties, const QString &configureScript,
+                       const QProcessEnvironment &environment);
+    void insert(const ProbeConstPtr &probe, const ProbeQueries &queries);
+    void store();
+
+private:
+    class Entry
+    {
+    public:
+        ProbeConstPtr probe;
+        ProbeQueries queries;
+        FileTime creationTime;
+
+        template<PersistentPool::OpType opType> void completeSerializationOp(PersistentPool &pool)
+        {
+            pool.serializationOp<opType>(probe, queries, creationTime);
+        }
+    };
+
+    void load();
+    QHash<QString, std::vector<Entry>> readEntries();
+    static void addEntry(QHash<QString, std::vector<Entry>> &entries, const Entry &entry);
+    static bool isUpToDate(const Entry &entry, const QProcessEnvironment &environment);
+
+    const QString m_filePath;
+    Logger &m_logger;
+    QHash<QString, std::vector<Entry>> m_entries;
+    std::vector<Entry> m_newEntries; // Not stored yet.
+    bool m_loaded = false;
+};
+
+} // namespace Internal
+} // namespace qbs
+
+#endif // Include guard.
@@ -276,6 +276,7 @@ TopLevelProjectPtr ProjectResolver::resolveTopLevelProject()
                 artifact->fileTags += "installable";
         }
     }
+    project->internPropertyMaps();
     project->warningsEncountered = m_logger.warnings();
     return project;
 }
@@ -1699,12 +1700,166 @@ QVariantMap ProjectResolver::evaluateModuleValues(Item *item, bool lookupPrototy
         if (!module.item->isPresentModule())
             continue;
         const QString fullName = module.name.toString();
-        moduleValues[fullName] = evaluateProperties(module.item, lookupPrototype, true);
+        moduleValues[fullName] = lookupPrototype && item == m_productContext->item
+                ? evaluateModuleProperties(module)
+                : evaluateProperties(module.item, lookupPrototype, true);
     }
 
     return moduleValues;
 }
 
+QVariantMap ProjectResolver::evaluateModuleProperties(const Item::Module &module)
+{
+    // A module instance without JavaScript values of its own evaluates like its prototype,
+    // apart from values set on the command line.
+    QVariantMap instanceValues;
+    std::vector<const Item *> moduleItems;
+    const Item *modulePrototype = module.item;
+    for (; modulePrototype && modulePrototype->type() == ItemType::ModuleInstance;
+         modulePrototype = modulePrototype->prototype()) {
+        moduleItems.push_back(modulePrototype);
+        const Item::PropertyMap &props = modulePrototype->properties();
+        for (auto it = props.cbegin(); it != props.cend(); ++it) {
+            switch (it.value()->type()) {
+            case Value::JSSourceValueType:
+                return evaluateProperties(module.item, true, true);
+            case Value::VariantValueType:
+                if (!instanceValues.contains(it.key())) {
+                    instanceValues.insert(it.key(), std::static_pointer_cast<VariantValue>(
+                                              it.value())->value());
+                }
+                break;
+            case Value::ItemValueType:
+                break;
+            }
+        }
+    }
+    if (!modulePrototype || modulePrototype->type() != ItemType::Module)
+        return evaluateProperties(module.item, true, true);
+    moduleItems.push_back(modulePrototype);
+
+    const Item * const productItem = m_productContext->item;
+    const Item * const projectItem = productItem->parent();
+    const QString &baseDir = m_productContext->product->sourceDirectory;
+    const auto inputItem = [productItem, projectItem](const ModuleValuesMemoEntry::Input &input)
+            -> const Item * {
+        switch (input.itemType) {
+        case ItemType::Product:
+            return productItem;
+        case ItemType::Project:
+            return projectItem;
+        default:
+            break;
+        }
+        for (const Item::Module &m : productItem->modules()) {
+            if (m.name.toString() == input.moduleName)
+                return m.item;
+        }
+        return nullptr;
+    };
+    const auto entryMatches = [&](const ModuleValuesMemoEntry &entry) {
+        if (entry.instanceValues != instanceValues)
+            return false;
+        if (!entry.pathPropertiesBaseDir.isEmpty() && entry.pathPropertiesBaseDir != baseDir)
+            return false;
+        for (const ModuleValuesMemoEntry::Input &input : entry.inputs) {
+            const Item * const item = inputItem(input);
+            if (!item)
+                return false;
+            const QScriptValue v = m_evaluator->property(item, input.propertyName);
+            if (m_evaluator->engine()->hasErrorOrException(v)) {
+                m_evaluator->engine()->clearExceptions();
+                return false;
+            }
+            if (v.toVariant() != input.value)
+                return false;
+        }
+        return true;
+    };
+
+    std::vector<ModuleValuesMemoEntry> &entries = m_moduleValuesMemo[modulePrototype];
+    for (const ModuleValuesMemoEntry &entry : entries) {
+        if (entryMatches(entry)) {
+            qCDebug(lcProjectResolver) << "reusing values of module" << module.name.toString()
+                                       << "for product" << m_productContext->product->name;
+            m_evaluator->addPropertyDependencies(entry.propertyDependencies);
+            return entry.values;
+        }
+    }
+
+    // Values cached before we start recording would hide what they were computed from.
+    static const size_t maxEntriesPerModule = 8;
+    if (entries.size() >= maxEntriesPerModule || m_evaluator->hasCachedValues(module.item))
+        return evaluateProperties(module.item, true, true);
+
+    EvaluationRecord record;
+    QVariantMap values;
+    {
+        struct RecordSetter {
+            RecordSetter(Evaluator *evaluator, EvaluationRecord *record) : evaluator(evaluator)
+            {
+                evaluator->setEvaluationRecord(record);
+            }
+            ~RecordSetter() { evaluator->setEvaluationRecord(nullptr); }
+            Evaluator * const evaluator;
+        } recordSetter(m_evaluator, &record);
+        values = evaluateProperties(module.item, true, true);
+    }
+    if (!record.complete)
+        return values;
+
+    ModuleValuesMemoEntry entry;
+    Set<std::pair<const Item *, QString>> seenInputs;
+    const auto isModuleItem = [&moduleItems](const Item *item) {
+        return contains(moduleItems, item);
+    };
+    const auto moduleName = [productItem](const Item *item) {
+        for (const Item::Module &m : productItem->modules()) {
+            if (m.item == item)
+                return m.name.toString();
+        }
+        return QString();
+    };
+    for (const EvaluationRecord::PropertyRead &read : record.propertyReads) {
+        if (read.itemValue) {
+            if (isModuleItem(read.itemValue) || read.itemValue == productItem
+                    || read.itemValue == projectItem
+                    || read.itemValue->type() == ItemType::ModulePrefix
+                    || !moduleName(read.itemValue).isEmpty()) {
+                continue;
+            }
+            return values;
+        }
+        if (isModuleItem(read.item)
+                || !seenInputs.insert(std::make_pair(read.item, read.name)).second) {
+            continue;
+        }
+        if (read.value.isFunction() || read.value.isError())
+            return values;
+        ModuleValuesMemoEntry::Input input;
+        input.itemType = ItemType::ModuleInstance;
+        if (read.item == productItem) {
+            input.itemType = ItemType::Product;
+        } else if (read.item == projectItem) {
+            input.itemType = ItemType::Project;
+        } else {
+            input.moduleName = moduleName(read.item);
+            if (input.moduleName.isEmpty())
+                return values;
+        }
+        input.propertyName = read.name;
+        input.value = read.value.toVariant();
+        entry.inputs.push_back(input);
+    }
+    entry.instanceValues = instanceValues;
+    if (record.usesPathPropertiesBaseDir)
+        entry.pathPropertiesBaseDir = baseDir;
+    entry.propertyDependencies = record.propertyDependencies;
+    entry.values = values;
+    entries.push_back(entry);
+    return values;
+}
+
 QVariantMap ProjectResolver::evaluateProperties(Item *item, bool lookupPrototype, bool checkErrors)
 {
     const QVariantMap tmplt;
@@ -52,6 +52,7 @@
 #include <QtCore/qmap.h>
 #include <QtCore/qstringlist.h>
 
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -125,6 +126,7 @@ private:
     void postProcess(const ResolvedProductPtr &product, ProjectContext *projectContext) const;
     void applyFileTaggers(const ResolvedProductPtr &product) const;
     QVariantMap evaluateModuleValues(Item *item, bool lookupPrototype = true);
+    QVariantMap evaluateModuleProperties(const Item::Module &module);
     QVariantMap evaluateProperties(Item *item, bool lookupPrototype, bool checkErrors);
     QVariantMap evaluateProperties(const Item *item, const Item *propertiesContainer,
                                    const QVariantMap &tmplt, bool lookupPrototype,
@@ -189,6 +191,28 @@ private:
     Set<CodeLocation> m_groupLocationWarnings;
     std::vector<std::pair<ResolvedProductPtr, Item *>> m_productExportInfo;
     std::vector<ErrorInfo> m_queuedErrors;
+
+    // Products with the same module configuration evaluate a module's properties to the same
+    // values. The keys are module prototypes, the values describe earlier evaluations of
+    // instances of these prototypes and everything the results depended on.
+    struct ModuleValuesMemoEntry
+    {
+        struct Input
+        {
+            QString moduleName; // Empty for product and project properties.
+            ItemType itemType;
+            QString propertyName;
+            QVariant value;
+        };
+
+        QVariantMap instanceValues;
+        QString pathPropertiesBaseDir;
+        std::vector<Input> inputs;
+        PropertyDependencies propertyDependencies;
+        QVariantMap values;
+    };
+    std::unordered_map<const Item *, std::vector<ModuleValuesMemoEntry>> m_moduleValuesMemo;
+
     qint64 m_elapsedTimeModPropEval;
     qint64 m_elapsedTimeAllPropEval;
     qint64 m_elapsedTimeGroups;
@@ -41,11 +41,38 @@
 
 #include <tools/jsliterals.h>
 #include <tools/scripttools.h>
+#include <tools/set.h>
 #include <tools/stringconstants.h>
 
+#include <algorithm>
+#include <mutex>
+
 namespace qbs {
 namespace Internal {
 
+// Looking up a module property in the nested maps means two searches with string comparisons.
+// Rules, scanners and JavaScript commands do that for the same few shared maps over and over,
+// so interned maps get an index from (module, property) pairs to the values. It is filled one
+// module at a time on first access and under a lock, because JavaScript commands query the maps
+// from their own threads. The entries point into m_value, which interned maps do not change.
+class PropertyMapInternal::ModuleIndex
+{
+public:
+    std::mutex mutex;
+    Set<QString> modules;
+    QHash<ModulePropertyPath, const QVariant *> properties;
+};
+
+static const QVariantMap *moduleMap(const QVariantMap &properties, const QString &moduleName)
+{
+    const auto moduleIt = properties.constFind(moduleName);
+    if (moduleIt == properties.constEnd()
+            || moduleIt.value().userType() != QMetaType::QVariantMap) {
+        return nullptr;
+    }
+    return static_cast<const QVariantMap *>(moduleIt.value().constData());
+}
+
 /*!
  * \class PropertyMapInternal
  * \brief The \c PropertyMapInternal class contains a set of properties and their values.
@@ -66,10 +93,39 @@ PropertyMapInternal::PropertyMapInternal(const PropertyMapInternal &other) : m_v
 {
 }
 
+PropertyMapInternal::~PropertyMapInternal()
+{
+}
+
 QVariant PropertyMapInternal::moduleProperty(const QString &moduleName, const QString &key,
                                              bool *isPresent) const
 {
-    return ::qbs::Internal::moduleProperty(m_value, moduleName, key, isPresent);
+    return moduleProperty(ModulePropertyPath(moduleName, key), isPresent);
+}
+
+QVariant PropertyMapInternal::moduleProperty(const ModulePropertyPath &path,
+                                             bool *isPresent) const
+{
+    const QVariant *value = nullptr;
+    if (m_moduleIndex) {
+        std::lock_guard<std::mutex> lock(m_moduleIndex->mutex);
+        if (m_moduleIndex->modules.insert(path.moduleName()).second) {
+            if (const QVariantMap * const map = moduleMap(m_value, path.moduleName())) {
+                for (auto it = map->constBegin(); it != map->constEnd(); ++it) {
+                    m_moduleIndex->properties.insert(
+                                ModulePropertyPath(path.moduleName(), it.key()), &it.value());
+                }
+            }
+        }
+        value = m_moduleIndex->properties.value(path);
+    } else if (const QVariantMap * const map = moduleMap(m_value, path.moduleName())) {
+        const auto it = map->constFind(path.propertyName());
+        if (it != map->constEnd())
+            value = &it.value();
+    }
+    if (isPresent)
+        *isPresent = value;
+    return value ? *value : QVariant();
 }
 
 QVariant PropertyMapInternal::qbsPropertyValue(const QString &key) const
@@ -85,6 +141,104 @@ QVariant PropertyMapInternal::property(const QStringList &name) const
 void PropertyMapInternal::setValue(const QVariantMap &map)
 {
     m_value = map;
+    if (m_moduleIndex)
+        m_moduleIndex.reset(new ModuleIndex);
+}
+
+/*!
+ * \class ModulePropertyPath
+ * \brief Identifies a property of a module in a \c PropertyMapInternal.
+ * The hash value is computed only once, so code that looks up the same property in many maps
+ * should keep the path around instead of passing the names to
+ * \c PropertyMapInternal::moduleProperty() every time.
+ */
+ModulePropertyPath::ModulePropertyPath(const QString &moduleName, const QString &propertyName)
+    : m_moduleName(moduleName)
+    , m_propertyName(propertyName)
+    , m_hash(qHash(propertyName, qHash(moduleName)))
+{
+}
+
+static uint combineHash(uint h1, uint h2)
+{
+    return ((h1 << 16) | (h1 >> 16)) ^ h2;
+}
+
+static uint variantHash(const QVariant &v)
+{
+    switch (static_cast<QMetaType::Type>(v.userType())) {
+    case QMetaType::QVariantMap: {
+        const QVariantMap map = v.toMap();
+        uint h = 0;
+        for (auto it = map.cbegin(); it != map.cend(); ++it)
+            h = combineHash(h, qHash(it.key()) ^ variantHash(it.value()));
+        return h;
+    }
+    case QMetaType::QVariantList: {
+        uint h = 0;
+        for (const QVariant &elem : v.toList())
+            h = combineHash(h, variantHash(elem));
+        return h;
+    }
+    case QMetaType::QStringList:
+        return qHash(v.toStringList());
+    default:
+        return combineHash(v.userType(), qHash(v.toString()));
+    }
+}
+
+/*!
+ * \class PropertyMapInterner
+ * \brief The \c PropertyMapInterner class makes sure that property maps with the same value
+ * are represented by the same object.
+ * This saves memory, lets comparisons succeed on pointer equality and lets the build graph
+ * store such maps only once. The maps handed out by \c intern() must not be modified anymore;
+ * to change a property map, clone it.
+ */
+PropertyMapPtr PropertyMapInterner::intern(const PropertyMapPtr &map)
+{
+    if (!map)
+        return map;
+    std::vector<std::weak_ptr<PropertyMapInternal>> &candidates = m_maps[variantHash(map->value())];
+    for (auto it = candidates.begin(); it != candidates.end();) {
+        const PropertyMapPtr candidate = it->lock();
+        if (!candidate) {
+            it = candidates.erase(it);
+            --m_mapCount;
+            continue;
+        }
+        if (*candidate == *map)
+            return candidate;
+        ++it;
+    }
+    if (!map->m_moduleIndex)
+        map->m_moduleIndex.reset(new PropertyMapInternal::ModuleIndex);
+    candidates.push_back(map);
+    if (++m_mapCount > 2 * m_mapCountAfterCleanup + 64)
+        removeExpiredMaps();
+    return map;
+}
+
+// Entries of maps that are gone would otherwise only get removed when a map with the same
+// hash value is interned. Cleaning up whenever the number of entries has doubled keeps the
+// cost per call constant on average.
+void PropertyMapInterner::removeExpiredMaps()
+{
+    m_mapCount = 0;
+    for (auto it = m_maps.begin(); it != m_maps.end();) {
+        std::vector<std::weak_ptr<PropertyMapInternal>> &candidates = it.value();
+        candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                        [](const std::weak_ptr<PropertyMapInternal> &map) {
+            return map.expired();
+        }), candidates.end());
+        if (candidates.empty()) {
+            it = m_maps.erase(it);
+        } else {
+            m_mapCount += int(candidates.size());
+            ++it;
+        }
+    }
+    m_mapCountAfterCleanup = m_mapCount;
 }
 
 QVariant moduleProperty(const QVariantMap &properties, const QString &moduleName,
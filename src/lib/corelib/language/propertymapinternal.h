@@ -43,20 +43,49 @@
 #include "forward_decls.h"
 #include <tools/persistence.h>
 #include <tools/qbs_export.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qvariant.h>
 
+#include <memory>
+#include <vector>
+
 namespace qbs {
 namespace Internal {
 
+class QBS_AUTOTEST_EXPORT ModulePropertyPath
+{
+public:
+    ModulePropertyPath(const QString &moduleName, const QString &propertyName);
+
+    const QString &moduleName() const { return m_moduleName; }
+    const QString &propertyName() const { return m_propertyName; }
+    uint hash() const { return m_hash; }
+
+private:
+    QString m_moduleName;
+    QString m_propertyName;
+    uint m_hash;
+};
+
+inline bool operator==(const ModulePropertyPath &lhs, const ModulePropertyPath &rhs)
+{
+    return lhs.hash() == rhs.hash() && lhs.propertyName() == rhs.propertyName()
+            && lhs.moduleName() == rhs.moduleName();
+}
+
+inline uint qHash(const ModulePropertyPath &path) { return path.hash(); }
+
 class QBS_AUTOTEST_EXPORT PropertyMapInternal
 {
 public:
     static PropertyMapPtr create() { return PropertyMapPtr(new PropertyMapInternal); }
     PropertyMapPtr clone() const { return PropertyMapPtr(new PropertyMapInternal(*this)); }
+    ~PropertyMapInternal();
 
     const QVariantMap &value() const { return m_value; }
     QVariant moduleProperty(const QString &moduleName,
                             const QString &key, bool *isPresent = nullptr) const;
+    QVariant moduleProperty(const ModulePropertyPath &path, bool *isPresent = nullptr) const;
     QVariant qbsPropertyValue(const QString &key) const; // Convenience function.
     QVariant property(const QStringList &name) const;
     void setValue(const QVariantMap &value);
@@ -69,17 +98,38 @@ public:
 private:
     friend bool operator==(const PropertyMapInternal &lhs, const PropertyMapInternal &rhs);
 
+    friend class PropertyMapInterner;
+
     PropertyMapInternal();
     PropertyMapInternal(const PropertyMapInternal &other);
 
+    class ModuleIndex;
+
     QVariantMap m_value;
+
+    // Only set for maps handed out by the PropertyMapInterner.
+    std::unique_ptr<ModuleIndex> m_moduleIndex;
 };
 
 inline bool operator==(const PropertyMapInternal &lhs, const PropertyMapInternal &rhs)
 {
-    return lhs.m_value == rhs.m_value;
+    return &lhs == &rhs || lhs.m_value == rhs.m_value;
 }
 
+class QBS_AUTOTEST_EXPORT PropertyMapInterner
+{
+public:
+    PropertyMapPtr intern(const PropertyMapPtr &map);
+    int mapCount() const { return m_mapCount; }
+
+private:
+    void removeExpiredMaps();
+
+    QHash<uint, std::vector<std::weak_ptr<PropertyMapInternal>>> m_maps;
+    int m_mapCount = 0;
+    int m_mapCountAfterCleanup = 0;
+};
+
 QVariant QBS_AUTOTEST_EXPORT moduleProperty(const QVariantMap &properties,
                                             const QString &moduleName,
                                             const QString &key, bool *isPresent = nullptr);
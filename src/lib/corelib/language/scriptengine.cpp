@@ -41,6 +41,7 @@
 
 #include "filecontextbase.h"
 #include "jsimports.h"
+#include "probecache.h"
 #include "propertymapinternal.h"
 #include "scriptimporter.h"
 #include "preparescriptobserver.h"
@@ -580,19 +581,64 @@ void ScriptEngine::addCanonicalFilePathResult(const QString &filePath,
 void ScriptEngine::addFileExistsResult(const QString &filePath, bool exists)
 {
     m_fileExistsResult.insert(filePath, exists);
+    if (m_probeQueries)
+        m_probeQueries->fileExistsResults.insert(filePath, exists);
 }
 
 void ScriptEngine::addDirectoryEntriesResult(const QString &path, QDir::Filters filters,
                                              const QStringList &entries)
 {
-    m_directoryEntriesResult.insert(
-                std::pair<QString, quint32>(path, static_cast<quint32>(filters)),
-                entries);
+    const std::pair<QString, quint32> key(path, static_cast<quint32>(filters));
+    m_directoryEntriesResult.insert(key, entries);
+    if (m_probeQueries)
+        m_probeQueries->directoryEntriesResults.insert(key, entries);
 }
 
 void ScriptEngine::addFileLastModifiedResult(const QString &filePath, const FileTime &fileTime)
 {
     m_fileLastModifiedResult.insert(filePath, fileTime);
+    if (m_probeQueries)
+        m_probeQueries->fileLastModifiedResults.insert(filePath, fileTime);
+}
+
+void ScriptEngine::startRecordingProbeQueries()
+{
+    m_probeQueries.reset(new ProbeQueries);
+}
+
+std::unique_ptr<ProbeQueries> ScriptEngine::takeProbeQueries()
+{
+    return std::move(m_probeQueries);
+}
+
+void ScriptEngine::addEnvironmentQuery(const QString &name, const QString &value)
+{
+    if (m_probeQueries)
+        m_probeQueries->environmentValues.insert(name, value);
+}
+
+void ScriptEngine::setWholeEnvironmentQueried()
+{
+    if (m_probeQueries)
+        m_probeQueries->usesWholeEnvironment = true;
+}
+
+// For probes whose configure script was run in a different engine.
+void ScriptEngine::addProbeQueryResults(const ProbeQueries &queries)
+{
+    for (auto it = queries.fileExistsResults.cbegin(); it != queries.fileExistsResults.cend();
+         ++it) {
+        addFileExistsResult(it.key(), it.value());
+    }
+    for (auto it = queries.directoryEntriesResults.cbegin();
+         it != queries.directoryEntriesResults.cend(); ++it) {
+        addDirectoryEntriesResult(it.key().first, static_cast<QDir::Filters>(it.key().second),
+                                  it.value());
+    }
+    for (auto it = queries.fileLastModifiedResults.cbegin();
+         it != queries.fileLastModifiedResults.cend(); ++it) {
+        addFileLastModifiedResult(it.key(), it.value());
+    }
 }
 
 Set<QString> ScriptEngine::imports() const
@@ -69,6 +69,7 @@ namespace Internal {
 class Artifact;
 class JsImport;
 class PrepareScriptObserver;
+class ProbeQueries;
 class ScriptImporter;
 class ScriptPropertyObserver;
 
@@ -199,6 +200,13 @@ public:
     }
 
     QHash<QString, FileTime> fileLastModifiedResults() const { return m_fileLastModifiedResult; }
+
+    // Collects the file system and environment queries of a probe's configure script.
+    void startRecordingProbeQueries();
+    std::unique_ptr<ProbeQueries> takeProbeQueries();
+    void addEnvironmentQuery(const QString &name, const QString &value);
+    void setWholeEnvironmentQueried();
+    void addProbeQueryResults(const ProbeQueries &queries);
     Set<QString> imports() const;
     static QScriptValueList argumentList(const QStringList &argumentNames,
             const QScriptValue &context);
@@ -332,6 +340,7 @@ private:
     QHash<QString, bool> m_fileExistsResult;
     QHash<std::pair<QString, quint32>, QStringList> m_directoryEntriesResult;
     QHash<QString, FileTime> m_fileLastModifiedResult;
+    std::unique_ptr<ProbeQueries> m_probeQueries;
     std::stack<QString> m_currentDirPathStack;
     std::stack<QStringList> m_extensionSearchPathsStack;
     QScriptValue m_loadFileFunction;
@@ -88,14 +88,14 @@ void Value::setNext(const ValuePtr &next)
 }
 
 
-JSSourceValue::JSSourceValue(bool createdByPropertiesBlock)
+JSSourceValue::JSSourceValue(PrivateTag, bool createdByPropertiesBlock)
     : Value(JSSourceValueType, createdByPropertiesBlock)
     , m_line(-1)
     , m_column(-1)
 {
 }
 
-JSSourceValue::JSSourceValue(const JSSourceValue &other) : Value(other)
+JSSourceValue::JSSourceValue(PrivateTag, const JSSourceValue &other) : Value(other)
 {
     m_sourceCode = other.m_sourceCode;
     m_line = other.m_line;
@@ -112,7 +112,7 @@ JSSourceValue::JSSourceValue(const JSSourceValue &other) : Value(other)
 
 JSSourceValuePtr JSSourceValue::create(bool createdByPropertiesBlock)
 {
-    return JSSourceValuePtr(new JSSourceValue(createdByPropertiesBlock));
+    return std::make_shared<JSSourceValue>(PrivateTag(), createdByPropertiesBlock);
 }
 
 JSSourceValue::~JSSourceValue()
@@ -121,7 +121,7 @@ JSSourceValue::~JSSourceValue()
 
 ValuePtr JSSourceValue::clone() const
 {
-    return JSSourceValuePtr(new JSSourceValue(*this));
+    return std::make_shared<JSSourceValue>(PrivateTag(), *this);
 }
 
 QString JSSourceValue::sourceCodeForEvaluation() const
@@ -166,7 +166,7 @@ void JSSourceValue::setDefiningItem(Item *item)
         a.value->setDefiningItem(item);
 }
 
-ItemValue::ItemValue(Item *item, bool createdByPropertiesBlock)
+ItemValue::ItemValue(PrivateTag, Item *item, bool createdByPropertiesBlock)
     : Value(ItemValueType, createdByPropertiesBlock)
     , m_item(item)
 {
@@ -175,7 +175,7 @@ ItemValue::ItemValue(Item *item, bool createdByPropertiesBlock)
 
 ItemValuePtr ItemValue::create(Item *item, bool createdByPropertiesBlock)
 {
-    return ItemValuePtr(new ItemValue(item, createdByPropertiesBlock));
+    return std::make_shared<ItemValue>(PrivateTag(), item, createdByPropertiesBlock);
 }
 
 ValuePtr ItemValue::clone() const
@@ -183,41 +183,47 @@ ValuePtr ItemValue::clone() const
     return create(m_item->clone(), createdByPropertiesBlock());
 }
 
-VariantValue::VariantValue(const QVariant &v)
+VariantValue::VariantValue(PrivateTag, const QVariant &v)
     : Value(VariantValueType, false)
     , m_value(v)
 {
 }
 
+VariantValue::VariantValue(PrivateTag, const VariantValue &other)
+    : Value(other)
+    , m_value(other.m_value)
+{
+}
+
 VariantValuePtr VariantValue::create(const QVariant &v)
 {
     if (!v.isValid())
         return invalidValue();
     if (static_cast<QMetaType::Type>(v.type()) == QMetaType::Bool)
         return v.toBool() ? VariantValue::trueValue() : VariantValue::falseValue();
-    return VariantValuePtr(new VariantValue(v));
+    return std::make_shared<VariantValue>(PrivateTag(), v);
 }
 
 ValuePtr VariantValue::clone() const
 {
-    return VariantValuePtr(new VariantValue(*this));
+    return std::make_shared<VariantValue>(PrivateTag(), *this);
 }
 
 const VariantValuePtr &VariantValue::falseValue()
 {
-    static const VariantValuePtr v = VariantValuePtr(new VariantValue(false));
+    static const VariantValuePtr v = std::make_shared<VariantValue>(PrivateTag(), false);
     return v;
 }
 
 const VariantValuePtr &VariantValue::trueValue()
 {
-    static const VariantValuePtr v = VariantValuePtr(new VariantValue(true));
+    static const VariantValuePtr v = std::make_shared<VariantValue>(PrivateTag(), true);
     return v;
 }
 
 const VariantValuePtr &VariantValue::invalidValue()
 {
-    static const VariantValuePtr v = VariantValuePtr(new VariantValue(QVariant()));
+    static const VariantValuePtr v = std::make_shared<VariantValue>(PrivateTag(), QVariant());
     return v;
 }
 
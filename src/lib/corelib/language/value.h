@@ -98,8 +98,10 @@ public:
 class JSSourceValue : public Value
 {
     friend class ItemReaderASTVisitor;
-    JSSourceValue(bool createdByPropertiesBlock);
-    JSSourceValue(const JSSourceValue &other);
+    Q_DISABLE_COPY(JSSourceValue)
+
+    // Lets create() and clone() use std::make_shared, which needs public constructors.
+    struct PrivateTag { };
 
     enum Flag
     {
@@ -114,6 +116,9 @@ class JSSourceValue : public Value
     Q_DECLARE_FLAGS(Flags, Flag)
 
 public:
+    JSSourceValue(PrivateTag, bool createdByPropertiesBlock);
+    JSSourceValue(PrivateTag, const JSSourceValue &other);
+
     static JSSourceValuePtr QBS_AUTOTEST_EXPORT create(bool createdByPropertiesBlock = false);
     ~JSSourceValue();
 
@@ -190,8 +195,10 @@ private:
 
 class ItemValue : public Value
 {
-    ItemValue(Item *item, bool createdByPropertiesBlock);
+    Q_DISABLE_COPY(ItemValue)
+    struct PrivateTag { }; // See JSSourceValue.
 public:
+    ItemValue(PrivateTag, Item *item, bool createdByPropertiesBlock);
     static ItemValuePtr create(Item *item, bool createdByPropertiesBlock = false);
 
     Item *item() const { return m_item; }
@@ -207,8 +214,11 @@ private:
 
 class VariantValue : public Value
 {
-    VariantValue(const QVariant &v);
+    Q_DISABLE_COPY(VariantValue)
+    struct PrivateTag { }; // See JSSourceValue.
 public:
+    VariantValue(PrivateTag, const QVariant &v);
+    VariantValue(PrivateTag, const VariantValue &other);
     static VariantValuePtr create(const QVariant &v = QVariant());
 
     void apply(ValueHandler *handler) override { handler->handle(this); }
@@ -71,6 +71,8 @@ public:
     bool removeExistingInstallation;
     bool onlyExecuteRules;
     bool jobLimitsFromProjectTakePrecedence = false;
+    bool criticalPathScheduling = false;
+    bool contentHashCheck = false;
 };
 
 } // namespace Internal
@@ -229,6 +231,50 @@ void BuildOptions::setProjectJobLimitsTakePrecedence(bool toggle)
     d->jobLimitsFromProjectTakePrecedence = toggle;
 }
 
+/*!
+ * \brief Returns true iff commands are scheduled according to the critical path of the build.
+ * The default is \c false.
+ * \sa setCriticalPathScheduling
+ */
+bool BuildOptions::criticalPathScheduling() const
+{
+    return d->criticalPathScheduling;
+}
+
+/*!
+ * \brief Controls the order in which qbs runs commands that are ready to be executed.
+ * If \a enabled is \c true, commands that start the longest remaining chain of work are
+ * preferred, where the cost of a command is estimated from its duration in the previous build.
+ * Otherwise, commands are scheduled according to the dependencies between products.
+ */
+void BuildOptions::setCriticalPathScheduling(bool enabled)
+{
+    d->criticalPathScheduling = enabled;
+}
+
+/*!
+ * \brief Returns true iff file contents are taken into account when checking whether
+ * an artifact is up to date.
+ * The default is \c false.
+ * \sa setContentHashCheck
+ */
+bool BuildOptions::contentHashCheck() const
+{
+    return d->contentHashCheck;
+}
+
+/*!
+ * \brief Controls whether file contents are taken into account when checking whether
+ * an artifact is up to date.
+ * If \a enabled is \c true, qbs records digests of the inputs of each command it runs.
+ * A command whose inputs are newer than its outputs is then only re-run if the contents
+ * of these inputs have actually changed.
+ */
+void BuildOptions::setContentHashCheck(bool enabled)
+{
+    d->contentHashCheck = enabled;
+}
+
 /*!
  * \brief Returns true iff qbs will not actually execute any commands, but just show what
  *        would happen.
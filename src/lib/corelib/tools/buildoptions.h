@@ -83,6 +83,12 @@ public:
     bool projectJobLimitsTakePrecedence() const;
     void setProjectJobLimitsTakePrecedence(bool toggle);
 
+    bool criticalPathScheduling() const;
+    void setCriticalPathScheduling(bool enabled);
+
+    bool contentHashCheck() const;
+    void setContentHashCheck(bool enabled);
+
     bool dryRun() const;
     void setDryRun(bool dryRun);
 
@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "dependencyfileparser.h"
+
+#include "set.h"
+
+#include <QtCore/qbytearray.h>
+
+namespace qbs {
+namespace Internal {
+
+QStringList parseDependencyFile(const QByteArray &content)
+{
+    QStringList prerequisites;
+    Set<QString> seenPrerequisites;
+    QByteArray currentWord;
+    bool inTargets = true;
+    const auto finishWord = [&] {
+        if (currentWord.isEmpty())
+            return;
+        if (!inTargets) {
+            const QString filePath = QString::fromLocal8Bit(currentWord);
+            if (seenPrerequisites.insert(filePath).second)
+                prerequisites << filePath;
+        }
+        currentWord.clear();
+    };
+    const auto isEndOfWord = [&content](int i) {
+        return i >= content.size() || content.at(i) == ' ' || content.at(i) == '\t'
+                || content.at(i) == '\r' || content.at(i) == '\n';
+    };
+
+    for (int i = 0; i < content.size(); ++i) {
+        const char c = content.at(i);
+        switch (c) {
+        case '\\':
+            if (i + 1 < content.size() && content.at(i + 1) == '\n') {
+                finishWord(); // Line continuation.
+                ++i;
+            } else if (i + 2 < content.size() && content.at(i + 1) == '\r'
+                       && content.at(i + 2) == '\n') {
+                finishWord();
+                i += 2;
+            } else if (i + 1 < content.size()
+                       && (content.at(i + 1) == ' ' || content.at(i + 1) == '#')) {
+                currentWord += content.at(++i); // Escaped character.
+            } else {
+                currentWord += c; // E.g. a Windows path separator.
+            }
+            break;
+        case '$':
+            if (i + 1 < content.size() && content.at(i + 1) == '$')
+                ++i;
+            currentWord += c;
+            break;
+        case ':':
+            // A colon that is not followed by white space is part of a path, as in "C:\dir".
+            if (inTargets && isEndOfWord(i + 1)) {
+                finishWord();
+                inTargets = false;
+            } else {
+                currentWord += c;
+            }
+            break;
+        case '\n':
+            finishWord();
+            inTargets = true;
+            break;
+        case ' ':
+        case '\t':
+        case '\r':
+            finishWord();
+            break;
+        default:
+            currentWord += c;
+            break;
+        }
+    }
+    finishWord();
+    return prerequisites;
+}
+
+} // namespace Internal
+} // namespace qbs
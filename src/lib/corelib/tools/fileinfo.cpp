@@ -51,6 +51,7 @@
 
 #if defined(Q_OS_UNIX)
 #include <errno.h>
+#include <string.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #elif defined(Q_OS_WIN)
@@ -315,6 +316,12 @@ FileInfo::FileInfo(const QString &fileName)
     }
 }
 
+FileInfo::FileInfo()
+{
+    ZeroMemory(z(m_stat), sizeof(WIN32_FILE_ATTRIBUTE_DATA));
+    z(m_stat)->dwFileAttributes = INVALID_FILE_ATTRIBUTES;
+}
+
 bool FileInfo::exists() const
 {
     return z(m_stat)->dwFileAttributes != INVALID_FILE_ATTRIBUTES;
@@ -361,6 +368,11 @@ FileInfo::FileInfo(const QString &fileName)
     }
 }
 
+FileInfo::FileInfo()
+{
+    memset(&m_stat, 0, sizeof m_stat);
+}
+
 bool FileInfo::exists() const
 {
     return m_stat.st_mode != 0;
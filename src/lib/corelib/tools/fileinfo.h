@@ -86,6 +86,11 @@ public:
     static bool fileExists(const QFileInfo &fi);
 
 private:
+    friend class FileStatCache;
+
+    // Describes a file that does not exist.
+    FileInfo();
+
 #if defined(Q_OS_WIN)
     struct InternalStatType
     {
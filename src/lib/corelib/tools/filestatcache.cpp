@@ -0,0 +1,195 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "filestatcache.h"
+
+#include "hostosinfo.h"
+#include "parallelfor.h"
+
+#include <logging/categories.h>
+
+#include <QtCore/qdir.h>
+
+#if defined(Q_OS_UNIX)
+#include <dirent.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#endif
+
+namespace qbs {
+namespace Internal {
+
+// Not using FileInfo::path(), which cleans the path: A file name like "dir/../file.h" must
+// not be looked up in the entries of "dir/..".
+static QString parentDirectory(const QString &filePath)
+{
+    const int slashIndex = filePath.lastIndexOf(QLatin1Char('/'));
+    if (slashIndex < 0)
+        return QString();
+    return slashIndex == 0 ? QStringLiteral("/") : filePath.left(slashIndex);
+}
+
+static QString joinPath(const QString &dirPath, const QString &fileName)
+{
+    return dirPath.endsWith(QLatin1Char('/')) ? dirPath + fileName
+                                              : dirPath + QLatin1Char('/') + fileName;
+}
+
+// On case-insensitive file systems, a file name that is not among the entries of a
+// directory might still refer to an existing file.
+static bool directoryListingsAreExhaustive()
+{
+    return !HostOsInfo::isWindowsHost() && !HostOsInfo::isMacosHost();
+}
+
+FileInfo FileStatCache::fileInfo(const QString &filePath)
+{
+    const auto it = m_fileInfos.find(filePath);
+    if (it != m_fileInfos.cend())
+        return it->second;
+    if (directoryListingsAreExhaustive()
+            && m_listedDirectories.count(parentDirectory(filePath)) > 0) {
+        return FileInfo();
+    }
+    const FileInfo fi(filePath);
+    if (m_cacheMisses || fi.exists())
+        m_fileInfos.emplace(filePath, fi);
+    return fi;
+}
+
+void FileStatCache::prefetchDirectories(const std::unordered_set<QString> &dirPaths)
+{
+    struct Listing
+    {
+        QString dirPath;
+        bool success = false;
+        DirectoryEntries entries;
+    };
+    std::vector<Listing> listings;
+    for (const QString &dirPath : dirPaths) {
+        if (!dirPath.isEmpty() && m_listedDirectories.count(dirPath) == 0)
+            listings.push_back(Listing{dirPath, false, DirectoryEntries()});
+    }
+    if (listings.empty())
+        return;
+
+    qCDebug(lcBuildGraph) << "reading" << listings.size() << "directories";
+    parallelFor(listings.size(), [&listings](std::size_t i) {
+        listings[i].success = readDirectory(listings[i].dirPath, listings[i].entries);
+    });
+
+    for (Listing &listing : listings) {
+        if (!listing.success)
+            continue;
+        for (std::pair<QString, FileInfo> &entry : listing.entries) {
+            const auto result = m_fileInfos.emplace(joinPath(listing.dirPath, entry.first),
+                                                    entry.second);
+            if (!result.second)
+                result.first->second = entry.second;
+        }
+        m_listedDirectories.insert(listing.dirPath);
+    }
+}
+
+void FileStatCache::invalidate(const QString &filePath)
+{
+    m_fileInfos.erase(filePath);
+    m_listedDirectories.erase(parentDirectory(filePath));
+}
+
+void FileStatCache::stopCachingMisses()
+{
+    m_cacheMisses = false;
+    m_listedDirectories.clear();
+    for (auto it = m_fileInfos.begin(); it != m_fileInfos.end();) {
+        if (it->second.exists())
+            ++it;
+        else
+            it = m_fileInfos.erase(it);
+    }
+}
+
+void FileStatCache::clear()
+{
+    m_fileInfos.clear();
+    m_listedDirectories.clear();
+    m_cacheMisses = true;
+}
+
+#if defined(Q_OS_UNIX)
+
+// readdir() fetches the entries in large batches via getdents(), and fstatat() saves the
+// kernel from resolving the directory part of each path again.
+bool FileStatCache::readDirectory(const QString &dirPath, DirectoryEntries &entries)
+{
+    DIR * const dir = opendir(dirPath.toLocal8Bit().constData());
+    if (!dir)
+        return false;
+    const int dirFd = dirfd(dir);
+    while (const dirent * const entry = readdir(dir)) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+            continue;
+        FileInfo fi;
+        if (fstatat(dirFd, entry->d_name, &fi.m_stat, 0) == -1)
+            fi = FileInfo(); // E.g. a dangling symlink, which stat() does not see either.
+        entries.emplace_back(QString::fromLocal8Bit(entry->d_name), fi);
+    }
+    closedir(dir);
+    return true;
+}
+
+#else
+
+bool FileStatCache::readDirectory(const QString &dirPath, DirectoryEntries &entries)
+{
+    const QDir dir(dirPath);
+    if (!dir.exists())
+        return false;
+    const QStringList fileNames = dir.entryList(QDir::AllEntries | QDir::NoDotAndDotDot
+                                                | QDir::Hidden | QDir::System);
+    for (const QString &fileName : fileNames)
+        entries.emplace_back(fileName, FileInfo(joinPath(dirPath, fileName)));
+    return true;
+}
+
+#endif
+
+} // namespace Internal
+} // namespace qbs
@@ -0,0 +1,89 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QBS_FILESTATCACHE_H
+#define QBS_FILESTATCACHE_H
+
+#include "fileinfo.h"
+#include "qttools.h"
+
+#include <QtCore/qstring.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace qbs {
+namespace Internal {
+
+// Remembers the results of stat() calls for the duration of one build, so that files that
+// are looked at by several stages of the up-to-date check hit the file system only once.
+// Whole directories can be read ahead of time using several threads. Whoever changes a file
+// must call invalidate() for it. Commands can also create files that nobody knows about, so
+// once they start running, stopCachingMisses() makes sure that looking up a file that was
+// missing so far always goes to the file system.
+class QBS_AUTOTEST_EXPORT FileStatCache
+{
+public:
+    FileInfo fileInfo(const QString &filePath);
+    bool exists(const QString &filePath) { return fileInfo(filePath).exists(); }
+    FileTime lastModified(const QString &filePath) { return fileInfo(filePath).lastModified(); }
+
+    void prefetchDirectories(const std::unordered_set<QString> &dirPaths);
+    void invalidate(const QString &filePath);
+    void stopCachingMisses();
+    void clear();
+
+private:
+    using DirectoryEntries = std::vector<std::pair<QString, FileInfo>>;
+    static bool readDirectory(const QString &dirPath, DirectoryEntries &entries);
+
+    std::unordered_map<QString, FileInfo> m_fileInfos;
+
+    // For these directories, a file without an entry in m_fileInfos does not exist.
+    std::unordered_set<QString> m_listedDirectories;
+    bool m_cacheMisses = true;
+};
+
+} // namespace Internal
+} // namespace qbs
+
+#endif // QBS_FILESTATCACHE_H
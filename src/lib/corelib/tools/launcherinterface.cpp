@@ -49,7 +49,11 @@
 #include <QtCore/qdebug.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qprocess.h>
+#include <QtCore/qthread.h>
 #include <QtNetwork/qlocalserver.h>
+#include <QtNetwork/qlocalsocket.h>
+
+#include <algorithm>
 
 #ifdef Q_OS_UNIX
 #include <unistd.h>
@@ -79,9 +83,19 @@ static QString launcherSocketName()
             .arg(QString::number(qApp->applicationPid()));
 }
 
+// Each launcher starts processes and collects their output in a single thread. With many
+// parallel jobs, spreading the work over several launchers keeps them from becoming the
+// bottleneck.
+static int launcherCount()
+{
+    return std::max(1, std::min(QThread::idealThreadCount() / 8, 4));
+}
+
 LauncherInterface::LauncherInterface()
-    : m_server(new QLocalServer(this)), m_socket(new LauncherSocket(this))
+    : m_server(new QLocalServer(this))
 {
+    for (int i = launcherCount(); --i >= 0;)
+        m_sockets.push_back(new LauncherSocket(this));
     QObject::connect(m_server, &QLocalServer::newConnection,
                      this, &LauncherInterface::handleNewConnection);
 }
@@ -107,18 +121,21 @@ void LauncherInterface::doStart()
         emit errorOccurred(ErrorInfo(m_server->errorString()));
         return;
     }
-    m_process = new LauncherProcess(this);
-    connect(m_process,
-            static_cast<void (QProcess::*)(QProcess::ProcessError)>(&QProcess::error),
-            this, &LauncherInterface::handleProcessError);
-    connect(m_process, static_cast<void (QProcess::*)(int)>(&QProcess::finished),
-            this, &LauncherInterface::handleProcessFinished);
-    connect(m_process, &QProcess::readyReadStandardError,
-            this, &LauncherInterface::handleProcessStderr);
-    m_process->start(qApp->applicationDirPath() + QLatin1Char('/')
-                            + QLatin1String(QBS_RELATIVE_LIBEXEC_PATH)
-                            + QLatin1String("/qbs_processlauncher"),
-                           QStringList(m_server->fullServerName()));
+    for (std::size_t i = 0; i < m_sockets.size(); ++i) {
+        const auto process = new LauncherProcess(this);
+        connect(process,
+                static_cast<void (QProcess::*)(QProcess::ProcessError)>(&QProcess::error),
+                this, [this, process] { handleProcessError(process); });
+        connect(process, static_cast<void (QProcess::*)(int)>(&QProcess::finished),
+                this, [this, process] { handleProcessFinished(process); });
+        connect(process, &QProcess::readyReadStandardError,
+                this, [this, process] { handleProcessStderr(process); });
+        process->start(qApp->applicationDirPath() + QLatin1Char('/')
+                       + QLatin1String(QBS_RELATIVE_LIBEXEC_PATH)
+                       + QLatin1String("/qbs_processlauncher"),
+                       QStringList(m_server->fullServerName()));
+        m_processes.push_back(process);
+    }
 }
 
 void LauncherInterface::doStop()
@@ -126,44 +143,61 @@ void LauncherInterface::doStop()
     if (--m_startRequests > 0)
         return;
     m_server->close();
-    if (!m_process)
-        return;
-    m_process->disconnect();
-    if (m_socket->isReady())
-        m_socket->shutdown();
-    m_process->waitForFinished(3000);
-    m_process->deleteLater();
-    m_process = nullptr;
+    for (LauncherProcess * const process : m_processes)
+        process->disconnect();
+    for (LauncherSocket * const socket : m_sockets) {
+        if (socket->isReady())
+            socket->shutdown();
+    }
+    for (LauncherProcess * const process : m_processes) {
+        process->waitForFinished(3000);
+        process->deleteLater();
+    }
+    m_processes.clear();
+}
+
+LauncherSocket *LauncherInterface::nextSocket()
+{
+    LauncherSocket * const socket = m_sockets.at(m_nextSocket);
+    m_nextSocket = (m_nextSocket + 1) % m_sockets.size();
+    return socket;
 }
 
 void LauncherInterface::handleNewConnection()
 {
-    QLocalSocket * const socket = m_server->nextPendingConnection();
-    if (!socket)
-        return;
-    m_server->close();
-    m_socket->setSocket(socket);
+    while (QLocalSocket * const socket = m_server->nextPendingConnection()) {
+        const auto launcherSocket = std::find_if(m_sockets.cbegin(), m_sockets.cend(),
+                                                 [](const LauncherSocket *s) {
+            return !s->isReady();
+        });
+        QBS_ASSERT(launcherSocket != m_sockets.cend(), delete socket; return);
+        (*launcherSocket)->setSocket(socket);
+    }
+    if (std::all_of(m_sockets.cbegin(), m_sockets.cend(),
+                    [](const LauncherSocket *s) { return s->isReady(); })) {
+        m_server->close();
+    }
 }
 
-void LauncherInterface::handleProcessError()
+void LauncherInterface::handleProcessError(LauncherProcess *process)
 {
-    if (m_process->error() == QProcess::FailedToStart) {
+    if (process->error() == QProcess::FailedToStart) {
         const QString launcherPathForUser
-                = QDir::toNativeSeparators(QDir::cleanPath(m_process->program()));
+                = QDir::toNativeSeparators(QDir::cleanPath(process->program()));
         emit errorOccurred(ErrorInfo(Tr::tr("Failed to start process launcher at '%1': %2")
-                                     .arg(launcherPathForUser, m_process->errorString())));
+                                     .arg(launcherPathForUser, process->errorString())));
     }
 }
 
-void LauncherInterface::handleProcessFinished()
+void LauncherInterface::handleProcessFinished(LauncherProcess *process)
 {
     emit errorOccurred(ErrorInfo(Tr::tr("Process launcher closed unexpectedly: %1")
-                                 .arg(m_process->errorString())));
+                                 .arg(process->errorString())));
 }
 
-void LauncherInterface::handleProcessStderr()
+void LauncherInterface::handleProcessStderr(LauncherProcess *process)
 {
-    qDebug() << "[launcher]" << m_process->readAllStandardError();
+    qDebug() << "[launcher]" << process->readAllStandardError();
 }
 
 } // namespace Internal
@@ -42,6 +42,8 @@
 
 #include <QtCore/qobject.h>
 
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 class QLocalServer;
 QT_END_NAMESPACE
@@ -61,7 +63,9 @@ public:
 
     static void startLauncher() { instance().doStart(); }
     static void stopLauncher() { instance().doStop(); }
-    static LauncherSocket *socket() { return instance().m_socket; }
+
+    // The processes are spread over the launchers by handing out their sockets in turn.
+    static LauncherSocket *socket() { return instance().nextSocket(); }
 
 signals:
     void errorOccurred(const ErrorInfo &error);
@@ -71,14 +75,16 @@ private:
 
     void doStart();
     void doStop();
+    LauncherSocket *nextSocket();
     void handleNewConnection();
-    void handleProcessError();
-    void handleProcessFinished();
-    void handleProcessStderr();
+    void handleProcessError(LauncherProcess *process);
+    void handleProcessFinished(LauncherProcess *process);
+    void handleProcessStderr(LauncherProcess *process);
 
     QLocalServer * const m_server;
-    LauncherSocket * const m_socket;
-    LauncherProcess * m_process = nullptr;
+    std::vector<LauncherSocket *> m_sockets;
+    std::vector<LauncherProcess *> m_processes;
+    std::size_t m_nextSocket = 0;
     int m_startRequests = 0;
 };
 
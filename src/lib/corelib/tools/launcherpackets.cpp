@@ -65,6 +65,22 @@ void LauncherPacket::deserialize(const QByteArray &data)
 }
 
 
+SetEnvironmentPacket::SetEnvironmentPacket(quintptr environmentId)
+    : LauncherPacket(LauncherPacketType::SetEnvironment, environmentId)
+{
+}
+
+void SetEnvironmentPacket::doSerialize(QDataStream &stream) const
+{
+    stream << env;
+}
+
+void SetEnvironmentPacket::doDeserialize(QDataStream &stream)
+{
+    stream >> env;
+}
+
+
 StartProcessPacket::StartProcessPacket(quintptr token)
     : LauncherPacket(LauncherPacketType::StartProcess, token)
 {
@@ -72,12 +88,12 @@ StartProcessPacket::StartProcessPacket(quintptr token)
 
 void StartProcessPacket::doSerialize(QDataStream &stream) const
 {
-    stream << command << arguments << workingDir << env;
+    stream << command << arguments << workingDir << environmentId;
 }
 
 void StartProcessPacket::doDeserialize(QDataStream &stream)
 {
-    stream >> command >> arguments >> workingDir >> env;
+    stream >> command >> arguments >> workingDir >> environmentId;
 }
 
 
@@ -125,7 +141,7 @@ void ProcessFinishedPacket::doSerialize(QDataStream &stream) const
 {
     stream << errorString << stdOut << stdErr
            << static_cast<quint8>(exitStatus) << static_cast<quint8>(error)
-           << exitCode;
+           << exitCode << cpuTime << peakMemoryUsage;
 }
 
 void ProcessFinishedPacket::doDeserialize(QDataStream &stream)
@@ -136,7 +152,7 @@ void ProcessFinishedPacket::doDeserialize(QDataStream &stream)
     exitStatus = static_cast<QProcess::ExitStatus>(val);
     stream >> val;
     error = static_cast<QProcess::ProcessError>(val);
-    stream >> exitCode;
+    stream >> exitCode >> cpuTime >> peakMemoryUsage;
 }
 
 ShutdownPacket::ShutdownPacket() : LauncherPacket(LauncherPacketType::Shutdown, 0) { }
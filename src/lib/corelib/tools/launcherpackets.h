@@ -52,7 +52,7 @@ namespace qbs {
 namespace Internal {
 
 enum class LauncherPacketType {
-    Shutdown, StartProcess, StopProcess, ProcessError, ProcessFinished
+    Shutdown, StartProcess, StopProcess, ProcessError, ProcessFinished, SetEnvironment
 };
 
 class PacketParser
@@ -105,6 +105,20 @@ private:
     virtual void doDeserialize(QDataStream &stream) = 0;
 };
 
+// Environments are sent only once per launcher and then referred to by their id,
+// which is the packet's token.
+class SetEnvironmentPacket : public LauncherPacket
+{
+public:
+    SetEnvironmentPacket(quintptr environmentId);
+
+    QStringList env;
+
+private:
+    void doSerialize(QDataStream &stream) const override;
+    void doDeserialize(QDataStream &stream) override;
+};
+
 class StartProcessPacket : public LauncherPacket
 {
 public:
@@ -113,7 +127,7 @@ public:
     QString command;
     QStringList arguments;
     QString workingDir;
-    QStringList env;
+    quintptr environmentId = 0;
 
 private:
     void doSerialize(QDataStream &stream) const override;
@@ -164,6 +178,8 @@ public:
     QProcess::ExitStatus exitStatus;
     QProcess::ProcessError error;
     int exitCode;
+    qint64 cpuTime = -1; // In milliseconds, negative if unknown.
+    qint64 peakMemoryUsage = -1; // In bytes, negative if unknown.
 
 private:
     void doSerialize(QDataStream &stream) const override;
@@ -66,6 +66,23 @@ void LauncherSocket::sendData(const QByteArray &data)
         QTimer::singleShot(0, this, &LauncherSocket::handleRequests);
 }
 
+// The launcher keeps the environments it has been sent, so a command that runs in the same
+// environment as an earlier one needs to transfer only the id. Ids stay valid for the lifetime
+// of this object, so clients can keep them.
+quintptr LauncherSocket::environmentId(const QStringList &env)
+{
+    std::lock_guard<std::mutex> locker(m_environmentsMutex);
+    const auto it = m_environmentIds.constFind(env);
+    if (it != m_environmentIds.constEnd())
+        return it.value();
+    const quintptr id = m_environmentIds.size() + 1;
+    SetEnvironmentPacket packet(id);
+    packet.env = env;
+    sendData(packet.serialize());
+    m_environmentIds.insert(env, id);
+    return id;
+}
+
 void LauncherSocket::shutdown()
 {
     QBS_ASSERT(m_socket, return);
@@ -80,6 +97,15 @@ void LauncherSocket::setSocket(QLocalSocket *socket)
 {
     QBS_ASSERT(!m_socket, return);
     m_socket = socket;
+    {
+        // A new launcher does not know any environments yet.
+        std::lock_guard<std::mutex> locker(m_environmentsMutex);
+        for (auto it = m_environmentIds.cbegin(); it != m_environmentIds.cend(); ++it) {
+            SetEnvironmentPacket packet(it.value());
+            packet.env = it.key();
+            sendData(packet.serialize());
+        }
+    }
     m_packetParser.setDevice(m_socket);
     connect(m_socket,
             static_cast<void(QLocalSocket::*)(QLocalSocket::LocalSocketError)>(&QLocalSocket::error),
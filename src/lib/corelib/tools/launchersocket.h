@@ -42,7 +42,9 @@
 
 #include "launcherpackets.h"
 
+#include <QtCore/qhash.h>
 #include <QtCore/qobject.h>
+#include <QtCore/qstringlist.h>
 
 #include <mutex>
 #include <vector>
@@ -62,6 +64,7 @@ class LauncherSocket : public QObject
 public:
     bool isReady() const { return m_socket; }
     void sendData(const QByteArray &data);
+    quintptr environmentId(const QStringList &env);
 
 signals:
     void ready();
@@ -85,6 +88,8 @@ private:
     PacketParser m_packetParser;
     std::vector<QByteArray> m_requests;
     std::mutex m_requestsMutex;
+    QHash<QStringList, quintptr> m_environmentIds;
+    std::mutex m_environmentsMutex;
 };
 
 } // namespace Internal
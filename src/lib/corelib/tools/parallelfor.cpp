@@ -0,0 +1,137 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "parallelfor.h"
+
+#include <QtCore/qrunnable.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace qbs {
+namespace Internal {
+
+namespace {
+
+// Shared between the calling thread and the helpers. A helper that gets to run only after
+// all items are done just finds nothing left to do; in particular, it never calls the work
+// function, which may refer to objects that no longer exist at that point.
+class ParallelForState
+{
+public:
+    ParallelForState(std::size_t count, const std::function<void(std::size_t)> &work)
+        : m_count(count), m_work(work) { }
+
+    void runItems()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_exception && m_next < m_count) {
+            const std::size_t index = m_next++;
+            lock.unlock();
+            try {
+                m_work(index);
+                lock.lock();
+            } catch (...) {
+                lock.lock();
+                if (!m_exception)
+                    m_exception = std::current_exception();
+            }
+            if (++m_finished == m_next && (m_exception || m_next == m_count))
+                m_done.notify_all();
+        }
+    }
+
+    void waitForFinished()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this] {
+            return m_finished == m_next && (m_exception || m_next == m_count);
+        });
+        if (m_exception)
+            std::rethrow_exception(m_exception);
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_done;
+    const std::size_t m_count;
+    std::size_t m_next = 0;
+    std::size_t m_finished = 0;
+    std::exception_ptr m_exception;
+    const std::function<void(std::size_t)> m_work;
+};
+
+class ParallelForHelper : public QRunnable
+{
+public:
+    ParallelForHelper(const std::shared_ptr<ParallelForState> &state) : m_state(state) { }
+
+private:
+    void run() override { m_state->runItems(); }
+
+    const std::shared_ptr<ParallelForState> m_state;
+};
+
+} // namespace
+
+void parallelFor(std::size_t count, const std::function<void(std::size_t)> &work,
+                 int maxThreadCount)
+{
+    if (maxThreadCount <= 0)
+        maxThreadCount = QThread::idealThreadCount();
+    const std::size_t threadCount = std::min(count, std::size_t(std::max(1, maxThreadCount)));
+    if (threadCount < 2) {
+        for (std::size_t i = 0; i < count; ++i)
+            work(i);
+        return;
+    }
+    const auto state = std::make_shared<ParallelForState>(count, work);
+    for (std::size_t i = 1; i < threadCount; ++i)
+        QThreadPool::globalInstance()->start(new ParallelForHelper(state));
+    state->runItems();
+    state->waitForFinished();
+}
+
+} // namespace Internal
+} // namespace qbs
@@ -0,0 +1,63 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QBS_PARALLELFOR_H
+#define QBS_PARALLELFOR_H
+
+#include "qbs_export.h"
+
+#include <cstddef>
+#include <functional>
+
+namespace qbs {
+namespace Internal {
+
+// Calls work(i) for every i in [0, count), using the calling thread plus threads from the
+// global thread pool. Returns when all calls have finished. Once a call has thrown, no new
+// items are started, and the first exception is rethrown in the calling thread.
+// The calling thread takes part in the work, so it is safe to call this function from
+// within a pool thread.
+QBS_AUTOTEST_EXPORT void parallelFor(std::size_t count,
+                                     const std::function<void(std::size_t)> &work,
+                                     int maxThreadCount = -1);
+
+} // namespace Internal
+} // namespace qbs
+
+#endif // Include guard
@@ -40,16 +40,42 @@
 #include "persistence.h"
 
 #include "fileinfo.h"
+#include "parallelfor.h"
 #include <logging/translator.h>
 #include <tools/error.h>
 
+#include <QtCore/qbuffer.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qthread.h>
+
+#include <algorithm>
+#include <limits>
 
 namespace qbs {
 namespace Internal {
 
+// The legacy format is a plain QDataStream in which every string is written inline at the place
+// it is first encountered. It is still accepted when loading, but no longer written.
 static const char QBS_PERSISTENCE_MAGIC[] = "QBSPERSISTENCE-124";
 
+// The mapped format is designed to be decoded directly from a memory-mapped file:
+//   - magic token
+//   - head data
+//   - qint64 offset of the index
+//   - the serialized objects, with strings referring to the string table by id
+//   - the string table: for every string id, a quint32 byte count and the UTF-8 data
+//   - the index: the number of strings and the file offset of each string table entry
+// Strings are decoded lazily, on first access.
+// The magic token is followed by the version of the data layout.
+static const char QBS_MAPPED_PERSISTENCE_MAGIC_PREFIX[] = "QBSPERSISTENCE-MAPPED-";
+
+static QByteArray mappedPersistenceMagic(int version)
+{
+    return QByteArray(QBS_MAPPED_PERSISTENCE_MAGIC_PREFIX) + QByteArray::number(version);
+}
+
 NoBuildGraphError::NoBuildGraphError(const QString &filePath)
     : ErrorInfo(Tr::tr("Build graph not found for configuration '%1'. Expected location was '%2'.")
                 .arg(FileInfo::completeBaseName(filePath), QDir::toNativeSeparators(filePath)))
@@ -76,25 +102,58 @@ void PersistentPool::load(const QString &filePath)
         throw ErrorInfo(Tr::tr("Could not open open build graph file '%1': %2")
                     .arg(filePath, file->errorString()));
     }
+    const qint64 fileSize = file->size();
+    if (fileSize > std::numeric_limits<int>::max()) {
+        throw ErrorInfo(Tr::tr("Cannot use stored build graph at '%1': File is too large.")
+                        .arg(filePath));
+    }
+
+    // Decoding from memory is a lot faster than going through the file device for every value.
+    closeStream();
+    if (const uchar * const data = file->map(0, fileSize)) {
+        m_fileData = QByteArray::fromRawData(reinterpret_cast<const char *>(data),
+                                             static_cast<int>(fileSize));
+    } else {
+        m_fileData = file->readAll();
+    }
+    m_mappedFile = std::move(file);
+    const auto buffer = new QBuffer;
+    buffer->setData(m_fileData);
+    buffer->open(QIODevice::ReadOnly);
+    m_stream.setDevice(buffer);
 
-    m_stream.setDevice(file.get());
     QByteArray magic;
     m_stream >> magic;
-    if (magic != QBS_PERSISTENCE_MAGIC) {
-        m_stream.setDevice(nullptr);
+    const QByteArray mappedPrefix(QBS_MAPPED_PERSISTENCE_MAGIC_PREFIX);
+    bool isKnownVersion = false;
+    if (magic.startsWith(mappedPrefix)) {
+        m_format = FileFormat::Mapped;
+        m_version = magic.mid(mappedPrefix.size()).toInt(&isKnownVersion);
+        isKnownVersion = isKnownVersion && m_version == CurrentVersion;
+    } else if (magic == QBS_PERSISTENCE_MAGIC) {
+        m_format = FileFormat::Stream;
+        m_version = BaseVersion;
+        isKnownVersion = true;
+    }
+    if (!isKnownVersion) {
+        closeStream();
         throw ErrorInfo(Tr::tr("Cannot use stored build graph at '%1': Incompatible file format. "
                            "Expected magic token '%2', got '%3'.")
-                    .arg(filePath, QString::fromLatin1(QBS_PERSISTENCE_MAGIC),
+                    .arg(filePath, QString::fromLatin1(mappedPersistenceMagic(CurrentVersion)),
                          QString::fromLatin1(magic)));
     }
 
     m_stream >> m_headData.projectConfig;
-    file.release();
     m_loadedRaw.clear();
     m_loaded.clear();
     m_storageIndices.clear();
     m_stringStorage.clear();
     m_inverseStringStorage.clear();
+    m_stringTableSize = 0;
+    if (m_format == FileFormat::Mapped) {
+        readIndex(filePath);
+        decodeStringTable(filePath);
+    }
 }
 
 void PersistentPool::setupWriteStream(const QString &filePath)
@@ -105,19 +164,21 @@ void PersistentPool::setupWriteStream(const QString &filePath)
                         .arg(dirPath));
     }
 
-    if (QFile::exists(filePath) && !QFile::remove(filePath)) {
-        throw ErrorInfo(Tr::tr("Failure storing build graph: Cannot remove old file '%1'")
-                        .arg(filePath));
-    }
-    QBS_CHECK(!QFile::exists(filePath));
-    std::unique_ptr<QFile> file(new QFile(filePath));
-    if (!file->open(QFile::WriteOnly)) {
+    // The data is written to a temporary file that replaces the old build graph only once
+    // it is complete, so an interrupted store operation cannot leave behind a corrupt file.
+    std::unique_ptr<QSaveFile> file(new QSaveFile(filePath));
+    if (!file->open(QIODevice::WriteOnly)) {
         throw ErrorInfo(Tr::tr("Failure storing build graph: "
                 "Cannot open file '%1' for writing: %2").arg(filePath, file->errorString()));
     }
 
     m_stream.setDevice(file.release());
-    m_stream << QByteArray(qstrlen(QBS_PERSISTENCE_MAGIC), 0) << m_headData.projectConfig;
+    m_stream << QByteArray(mappedPersistenceMagic(CurrentVersion).size(), 0)
+             << m_headData.projectConfig;
+    m_indexOffsetPos = m_stream.device()->pos();
+    m_stream << qint64(0);
+    m_format = FileFormat::Mapped;
+    m_version = CurrentVersion;
     m_lastStoredObjectId = 0;
     m_lastStoredStringId = 0;
     m_lastStoredEnvId = 0;
@@ -128,25 +189,122 @@ void PersistentPool::finalizeWriteStream()
 {
     if (m_stream.status() != QDataStream::Ok)
         throw ErrorInfo(Tr::tr("Failure serializing build graph."));
+    writeIndex();
     m_stream.device()->seek(0);
-    m_stream << QByteArray(QBS_PERSISTENCE_MAGIC);
+    m_stream << mappedPersistenceMagic(CurrentVersion);
     if (m_stream.status() != QDataStream::Ok)
         throw ErrorInfo(Tr::tr("Failure serializing build graph."));
-    const auto file = static_cast<QFile *>(m_stream.device());
-    if (!file->flush()) {
-        file->close();
-        file->remove();
+    const auto file = static_cast<QSaveFile *>(m_stream.device());
+    if (!file->commit())
         throw ErrorInfo(Tr::tr("Failure serializing build graph: %1").arg(file->errorString()));
-    }
 }
 
 void PersistentPool::closeStream()
 {
     delete m_stream.device();
     m_stream.setDevice(nullptr);
+    m_fileData.clear();
+    m_mappedFile.reset();
 }
 
+void PersistentPool::readIndex(const QString &filePath)
+{
+    const ErrorInfo corruptFileError(Tr::tr("Cannot use stored build graph at '%1': "
+                                            "The file is corrupt.").arg(filePath));
+    qint64 indexOffset;
+    m_stream >> indexOffset;
+    if (m_stream.status() != QDataStream::Ok || indexOffset <= 0
+            || indexOffset >= m_fileData.size()) {
+        throw corruptFileError;
+    }
 
+    QIODevice * const device = m_stream.device();
+    const qint64 bodyOffset = device->pos();
+    device->seek(indexOffset);
+    quint32 stringCount;
+    m_stream >> stringCount;
+    m_stringTableOffset = device->pos();
+    const qint64 indexEnd = m_stringTableOffset + qint64(stringCount) * sizeof(qint64);
+    if (m_stream.status() != QDataStream::Ok || indexEnd != m_fileData.size())
+        throw corruptFileError;
+
+    m_stringTableSize = static_cast<PersistentObjectId>(stringCount);
+    m_stringStorage.resize(stringCount);
+    device->seek(bodyOffset);
+}
+
+void PersistentPool::writeIndex()
+{
+    QIODevice * const device = m_stream.device();
+    std::vector<const QString *> strings(m_lastStoredStringId);
+    for (auto it = m_inverseStringStorage.cbegin(); it != m_inverseStringStorage.cend(); ++it)
+        strings.at(it.value()) = &it.key();
+    std::vector<qint64> stringOffsets;
+    stringOffsets.reserve(strings.size());
+    for (const QString * const s : strings) {
+        stringOffsets.push_back(device->pos());
+        const QByteArray utf8 = s->toUtf8();
+        m_stream << quint32(utf8.size());
+        m_stream.writeRawData(utf8.constData(), utf8.size());
+    }
+
+    const qint64 indexOffset = device->pos();
+    m_stream << quint32(stringOffsets.size());
+    for (const qint64 offset : stringOffsets)
+        m_stream << offset;
+    device->seek(m_indexOffsetPos);
+    m_stream << indexOffset;
+}
+
+bool PersistentPool::decodeString(PersistentObjectId id)
+{
+    const char * const data = m_fileData.constData();
+    const qint64 offset = qFromBigEndian<qint64>(data + m_stringTableOffset
+                                                 + qint64(id) * sizeof(qint64));
+    if (offset <= 0 || offset + qint64(sizeof(quint32)) > m_fileData.size())
+        return false;
+    const quint32 size = qFromBigEndian<quint32>(data + offset);
+    if (offset + qint64(sizeof(quint32)) + size > m_fileData.size())
+        return false;
+    m_stringStorage[id] = QString::fromUtf8(data + offset + sizeof(quint32),
+                                            static_cast<int>(size));
+    return true;
+}
+
+// For large build graphs, the strings are decoded up front on several threads. Small string
+// tables are decoded lazily, as the thread overhead would outweigh the gain.
+// This is the only part of loading that runs concurrently. The objects are restored in order
+// on one thread: an object is stored in full only where it is first referenced, and later
+// references are just its id, so products cannot be decoded independently of each other.
+void PersistentPool::decodeStringTable(const QString &filePath)
+{
+    static const PersistentObjectId minStringsPerThread = 4096;
+    const int threadCount = std::min(QThread::idealThreadCount(),
+                                     m_stringTableSize / minStringsPerThread);
+    if (threadCount < 2)
+        return;
+    const PersistentObjectId chunkSize = (m_stringTableSize + threadCount - 1) / threadCount;
+    parallelFor(threadCount, [this, chunkSize, &filePath](std::size_t chunk) {
+        const PersistentObjectId begin = PersistentObjectId(chunk) * chunkSize;
+        const PersistentObjectId end = std::min(begin + chunkSize, m_stringTableSize);
+        for (PersistentObjectId id = begin; id < end; ++id) {
+            if (!decodeString(id)) {
+                throw ErrorInfo(Tr::tr("Cannot use stored build graph at '%1': "
+                                       "The file is corrupt.").arg(filePath));
+            }
+        }
+    }, threadCount);
+}
+
+QString PersistentPool::loadStringFromTable(PersistentObjectId id)
+{
+    QBS_CHECK(id < m_stringTableSize);
+    if (m_stringStorage.at(id).isNull()) {
+        const bool decoded = decodeString(id);
+        QBS_CHECK(decoded);
+    }
+    return m_stringStorage.at(id);
+}
 
 void PersistentPool::storeVariant(const QVariant &variant)
 {
@@ -223,7 +381,8 @@ void PersistentPool::doLoadValue(QProcessEnvironment &env)
 
 void PersistentPool::doStoreValue(const QString &s)
 {
-    m_stream << s;
+    // Nothing to do here. The string table is written in finalizeWriteStream().
+    Q_UNUSED(s);
 }
 
 void PersistentPool::doStoreValue(const QStringList &l)
@@ -42,10 +42,13 @@
 
 #include "error.h"
 #include <logging/logger.h>
+#include <tools/qbs_export.h>
 #include <tools/qbsassert.h>
 #include <tools/qttools.h>
 
+#include <QtCore/qbytearray.h>
 #include <QtCore/qdatastream.h>
+#include <QtCore/qfile.h>
 #include <QtCore/qflags.h>
 #include <QtCore/qprocess.h>
 #include <QtCore/qregexp.h>
@@ -69,12 +72,21 @@ public:
 template<typename T, typename Enable = void>
 struct PPHelper;
 
-class PersistentPool
+class QBS_AUTOTEST_EXPORT PersistentPool
 {
 public:
     PersistentPool(Logger &logger);
     ~PersistentPool();
 
+    // Increase CurrentVersion whenever the serialized data changes. Data that was added after
+    // BaseVersion must only be loaded if version() indicates that it is present.
+    enum Version {
+        BaseVersion = 124,      // The legacy stream format.
+        MappedVersion = 125,    // Memory-mappable layout, command resource usage, dependency
+                                // files, content hashes and wildcard directory listings.
+        CurrentVersion = MappedVersion
+    };
+
     class HeadData
     {
     public:
@@ -131,12 +143,22 @@ public:
     void closeStream();
     void clear();
 
+    int version() const { return m_version; }
+
     const HeadData &headData() const { return m_headData; }
     void setHeadData(const HeadData &hd) { m_headData = hd; }
 
 private:
     typedef int PersistentObjectId;
 
+    enum class FileFormat { Stream, Mapped };
+
+    void readIndex(const QString &filePath);
+    void writeIndex();
+    bool decodeString(PersistentObjectId id);
+    void decodeStringTable(const QString &filePath);
+    QString loadStringFromTable(PersistentObjectId id);
+
     template <typename T> T *idLoad();
     template <class T> std::shared_ptr<T> idLoadS();
     template <typename T> T idLoadValue();
@@ -168,6 +190,13 @@ private:
     static const PersistentObjectId EmptyValueId = -2;
 
     QDataStream m_stream;
+    FileFormat m_format = FileFormat::Mapped;
+    int m_version = CurrentVersion;
+    std::unique_ptr<QFile> m_mappedFile;
+    QByteArray m_fileData;
+    qint64 m_indexOffsetPos = 0;
+    qint64 m_stringTableOffset = 0;
+    PersistentObjectId m_stringTableSize = 0;
     HeadData m_headData;
     std::vector<void *> m_loadedRaw;
     std::vector<std::shared_ptr<void>> m_loaded;
@@ -302,6 +331,25 @@ template<typename T> inline T PersistentPool::idLoadValue()
     return idStorage<T>().at(id);
 }
 
+template<> inline QString PersistentPool::idLoadValue<QString>()
+{
+    int id;
+    m_stream >> id;
+    if (id == EmptyValueId)
+        return QString();
+    QBS_CHECK(id >= 0);
+    if (m_format == FileFormat::Mapped)
+        return loadStringFromTable(id);
+    if (id >= static_cast<int>(m_stringStorage.size())) {
+        QString value;
+        doLoadValue(value);
+        m_stringStorage.resize(id + 1);
+        m_stringStorage[id] = value;
+        return value;
+    }
+    return m_stringStorage.at(id);
+}
+
 template<typename T>
 void PersistentPool::idStoreValue(const T &value)
 {
@@ -420,6 +468,12 @@ template<typename T> struct PPHelper<T, std::enable_if_t<std::is_same<T, QString
     static void load(T &v, PersistentPool *pool) { v = pool->idLoadValue<T>(); }
 };
 
+template<> struct PPHelper<QByteArray>
+{
+    static void store(const QByteArray &ba, PersistentPool *pool) { pool->m_stream << ba; }
+    static void load(QByteArray &ba, PersistentPool *pool) { pool->m_stream >> ba; }
+};
+
 template<> struct PPHelper<QVariant>
 {
     static void store(const QVariant &v, PersistentPool *pool) { pool->storeVariant(v); }
@@ -97,6 +97,15 @@ QString Preferences::defaultBuildDirectory() const
     return getPreference(QLatin1String("defaultBuildDirectory")).toString();
 }
 
+/*!
+ * \brief Returns the directory in which probe results are shared between projects and build
+ * directories. If the string is empty, no such sharing takes place.
+ */
+QString Preferences::probeCacheDirectory() const
+{
+    return getPreference(QLatin1String("probeCacheDirectory")).toString();
+}
+
 /*!
  * \brief Returns the default echo mode used by Qbs if none is specified.
  */
@@ -61,6 +61,7 @@ public:
     int jobs() const;
     QString shell() const;
     QString defaultBuildDirectory() const;
+    QString probeCacheDirectory() const;
     CommandEchoMode defaultEchoMode() const;
     QStringList searchPaths(const QString &baseDir = QString()) const;
     QStringList pluginPaths(const QString &baseDir = QString()) const;
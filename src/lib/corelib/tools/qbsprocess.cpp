@@ -51,14 +51,12 @@
 namespace qbs {
 namespace Internal {
 
-QbsProcess::QbsProcess(QObject *parent) : QObject(parent)
+QbsProcess::QbsProcess(QObject *parent)
+    : QObject(parent), m_socket(LauncherInterface::socket())
 {
-    connect(LauncherInterface::socket(), &LauncherSocket::ready,
-            this, &QbsProcess::handleSocketReady);
-    connect(LauncherInterface::socket(), &LauncherSocket::errorOccurred,
-            this, &QbsProcess::handleSocketError);
-    connect(LauncherInterface::socket(), &LauncherSocket::packetArrived,
-            this, &QbsProcess::handlePacket);
+    connect(m_socket, &LauncherSocket::ready, this, &QbsProcess::handleSocketReady);
+    connect(m_socket, &LauncherSocket::errorOccurred, this, &QbsProcess::handleSocketError);
+    connect(m_socket, &LauncherSocket::packetArrived, this, &QbsProcess::handlePacket);
 }
 
 void QbsProcess::start(const QString &command, const QStringList &arguments)
@@ -70,8 +68,10 @@ void QbsProcess::start(const QString &command, const QStringList &arguments)
     }
     m_command = command;
     m_arguments = arguments;
+    m_cpuTime = -1;
+    m_peakMemoryUsage = -1;
     m_state = QProcess::Starting;
-    if (LauncherInterface::socket()->isReady())
+    if (m_socket->isReady())
         doStart();
 }
 
@@ -81,7 +81,11 @@ void QbsProcess::doStart()
     StartProcessPacket p(token());
     p.command = m_command;
     p.arguments = m_arguments;
-    p.env = m_environment.toStringList();
+    if (m_environmentId == 0 || m_environment != m_environmentOfId) {
+        m_environmentId = m_socket->environmentId(m_environment.toStringList());
+        m_environmentOfId = m_environment;
+    }
+    p.environmentId = m_environmentId;
     p.workingDir = m_workingDirectory;
     sendPacket(p);
 }
@@ -115,7 +119,7 @@ QByteArray QbsProcess::readAllStandardError()
 
 void QbsProcess::sendPacket(const LauncherPacket &packet)
 {
-    LauncherInterface::socket()->sendData(packet.serialize());
+    m_socket->sendData(packet.serialize());
 }
 
 QByteArray QbsProcess::readAndClear(QByteArray &data)
@@ -178,6 +182,8 @@ void QbsProcess::handleFinishedPacket(const QByteArray &packetData)
     m_stdout = packet.stdOut;
     m_stderr = packet.stdErr;
     m_errorString = packet.errorString;
+    m_cpuTime = packet.cpuTime;
+    m_peakMemoryUsage = packet.peakMemoryUsage;
     emit finished(m_exitCode);
 }
 
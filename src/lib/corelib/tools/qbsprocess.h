@@ -49,6 +49,7 @@
 
 namespace qbs {
 namespace Internal {
+class LauncherSocket;
 
 class QbsProcess : public QObject
 {
@@ -67,6 +68,8 @@ public:
     int exitCode() const { return m_exitCode; }
     QProcess::ProcessError error() const { return m_error; }
     QString errorString() const { return m_errorString; }
+    qint64 cpuTime() const { return m_cpuTime; }
+    qint64 peakMemoryUsage() const { return m_peakMemoryUsage; }
 
 signals:
     void error(QProcess::ProcessError error);
@@ -86,9 +89,15 @@ private:
 
     quintptr token() const { return reinterpret_cast<quintptr>(this); }
 
+    LauncherSocket * const m_socket;
     QString m_command;
     QStringList m_arguments;
     QProcessEnvironment m_environment;
+
+    // The commands of a product usually share its build environment, so this comparison
+    // is mostly a pointer check.
+    QProcessEnvironment m_environmentOfId;
+    quintptr m_environmentId = 0;
     QString m_workingDirectory;
     QByteArray m_stdout;
     QByteArray m_stderr;
@@ -96,6 +105,8 @@ private:
     QProcess::ProcessError m_error = QProcess::UnknownError;
     QProcess::ProcessState m_state = QProcess::NotRunning;
     int m_exitCode;
+    qint64 m_cpuTime = -1;
+    qint64 m_peakMemoryUsage = -1;
     int m_connectionAttempts = 0;
     bool m_socketError = false;
 };
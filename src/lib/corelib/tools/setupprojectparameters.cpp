@@ -67,6 +67,7 @@ public:
         , dryRun(false)
         , logElapsedTime(false)
         , forceProbeExecution(false)
+        , concurrentProbeExecution(false)
         , waitLockBuildGraph(false)
         , restoreBehavior(SetupProjectParameters::RestoreAndTrackChanges)
         , propertyCheckingMode(ErrorHandlingMode::Relaxed)
@@ -91,6 +92,7 @@ public:
     bool dryRun;
     bool logElapsedTime;
     bool forceProbeExecution;
+    bool concurrentProbeExecution;
     bool waitLockBuildGraph;
     SetupProjectParameters::RestoreBehavior restoreBehavior;
     ErrorHandlingMode propertyCheckingMode;
@@ -491,6 +493,24 @@ void SetupProjectParameters::setForceProbeExecution(bool force)
     d->forceProbeExecution = force;
 }
 
+/*!
+ * \brief Returns true iff the configure scripts of probes should run in parallel.
+ */
+bool SetupProjectParameters::concurrentProbeExecution() const
+{
+    return d->concurrentProbeExecution;
+}
+
+/*!
+ * Controls whether the configure scripts of a product's probes run in parallel, each in its own
+ * script engine. The results are the same as with serial execution; a probe whose input
+ * properties depend on another probe's results is run again after that probe.
+ */
+void SetupProjectParameters::setConcurrentProbeExecution(bool concurrent)
+{
+    d->concurrentProbeExecution = concurrent;
+}
+
 /*!
  * \brief Returns true if qbs should wait for the build graph lock to become available,
  * otherwise qbs will exit immediately if the lock cannot be acquired.
@@ -120,6 +120,9 @@ public:
     bool forceProbeExecution() const;
     void setForceProbeExecution(bool force);
 
+    bool concurrentProbeExecution() const;
+    void setConcurrentProbeExecution(bool concurrent);
+
     bool waitLockBuildGraph() const;
     void setWaitLockBuildGraph(bool wait);
 
@@ -12,11 +12,13 @@ HEADERS += \
     $$PWD/buildgraphlocker.h \
     $$PWD/codelocation.h \
     $$PWD/commandechomode.h \
+    $$PWD/dependencyfileparser.h \
     $$PWD/dynamictypecheck.h \
     $$PWD/error.h \
     $$PWD/executablefinder.h \
     $$PWD/fileinfo.h \
     $$PWD/filesaver.h \
+    $$PWD/filestatcache.h \
     $$PWD/filetime.h \
     $$PWD/generateoptions.h \
     $$PWD/id.h \
@@ -27,6 +29,7 @@ HEADERS += \
     $$PWD/launcherpackets.h \
     $$PWD/launchersocket.h \
     $$PWD/msvcinfo.h \
+    $$PWD/parallelfor.h \
     $$PWD/persistence.h \
     $$PWD/scannerpluginmanager.h \
     $$PWD/scripttools.h \
@@ -69,10 +72,12 @@ SOURCES += \
     $$PWD/buildgraphlocker.cpp \
     $$PWD/codelocation.cpp \
     $$PWD/commandechomode.cpp \
+    $$PWD/dependencyfileparser.cpp \
     $$PWD/error.cpp \
     $$PWD/executablefinder.cpp \
     $$PWD/fileinfo.cpp \
     $$PWD/filesaver.cpp \
+    $$PWD/filestatcache.cpp \
     $$PWD/filetime.cpp \
     $$PWD/generateoptions.cpp \
     $$PWD/id.cpp \
@@ -82,6 +87,7 @@ SOURCES += \
     $$PWD/launcherpackets.cpp \
     $$PWD/launchersocket.cpp \
     $$PWD/msvcinfo.cpp \
+    $$PWD/parallelfor.cpp \
     $$PWD/persistence.cpp \
     $$PWD/scannerpluginmanager.cpp \
     $$PWD/scripttools.cpp \
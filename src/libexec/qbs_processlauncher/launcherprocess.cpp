@@ -0,0 +1,479 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include "launcherprocess.h"
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qtimer.h>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+// posix_spawn() has no portable way to set the working directory of the child.
+#if defined(Q_OS_LINUX) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 29)
+#define QBS_HAS_SPAWN_CHDIR
+#endif
+#endif
+
+#ifdef QBS_HAS_SPAWN_CHDIR
+#include <QtCore/qsocketnotifier.h>
+#include <QtCore/qstandardpaths.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unordered_map>
+#endif
+
+namespace qbs {
+namespace Internal {
+
+EnvironmentBlock::EnvironmentBlock(const QStringList &entries) : m_entries(entries)
+{
+    m_encodedEntries.reserve(entries.size());
+    for (const QString &entry : entries)
+        m_encodedEntries.push_back(entry.toLocal8Bit());
+    m_pointers.reserve(m_encodedEntries.size() + 1);
+    for (QByteArray &entry : m_encodedEntries)
+        m_pointers.push_back(entry.data());
+    m_pointers.push_back(nullptr);
+}
+
+Process::Process(quintptr token, QObject *parent)
+    : QObject(parent), m_token(token), m_stopTimer(new QTimer(this))
+{
+    m_stopTimer->setSingleShot(true);
+    connect(m_stopTimer, &QTimer::timeout, this, &Process::cancel);
+}
+
+void Process::cancel()
+{
+    switch (m_stopState) {
+    case StopState::Inactive:
+        m_stopState = StopState::Terminating;
+        m_stopTimer->start(3000);
+        terminate();
+        break;
+    case StopState::Terminating:
+        m_stopState = StopState::Killing;
+        m_stopTimer->start(3000);
+        kill();
+        break;
+    case StopState::Killing:
+        m_stopState = StopState::Inactive;
+        emit failedToStop();
+        break;
+    }
+}
+
+void Process::stopStopProcedure()
+{
+    m_stopState = StopState::Inactive;
+    m_stopTimer->stop();
+}
+
+class QtProcess : public Process
+{
+public:
+    QtProcess(quintptr token, QObject *parent) : Process(token, parent), m_process(this)
+    {
+        connect(&m_process,
+                static_cast<void (QProcess::*)(QProcess::ProcessError)>(&QProcess::error),
+                this, [this](QProcess::ProcessError error) {
+            if (error == QProcess::FailedToStart)
+                emit failedToStart();
+        });
+        connect(&m_process, static_cast<void (QProcess::*)(int)>(&QProcess::finished),
+                this, &Process::finished);
+    }
+
+    void start(const QString &command, const QStringList &arguments, const QString &workingDir,
+               const EnvironmentBlockPtr &env) override
+    {
+        m_process.setEnvironment(env->entries());
+        m_process.setWorkingDirectory(workingDir);
+        m_process.start(command, arguments);
+    }
+
+    bool isRunning() const override { return m_process.state() != QProcess::NotRunning; }
+    QProcess::ProcessError error() const override { return m_process.error(); }
+    QString errorString() const override { return m_process.errorString(); }
+    int exitCode() const override { return m_process.exitCode(); }
+    QProcess::ExitStatus exitStatus() const override { return m_process.exitStatus(); }
+    QByteArray readAllStandardOutput() override { return m_process.readAllStandardOutput(); }
+    QByteArray readAllStandardError() override { return m_process.readAllStandardError(); }
+    void terminate() override { m_process.terminate(); }
+    void kill() override { m_process.kill(); }
+
+private:
+    QProcess m_process;
+};
+
+#ifdef QBS_HAS_SPAWN_CHDIR
+
+class SpawnedProcess;
+
+// Reaps the children started via posix_spawn(). The signal handler only writes to a pipe;
+// the actual work happens in the event loop.
+class ChildReaper : public QObject
+{
+public:
+    static ChildReaper &instance()
+    {
+        static ChildReaper * const reaper = new ChildReaper;
+        return *reaper;
+    }
+
+    void add(pid_t pid, SpawnedProcess *process) { m_processes[pid] = process; }
+    void remove(pid_t pid) { m_processes.erase(pid); }
+
+private:
+    ChildReaper();
+
+    static void handleSignal(int)
+    {
+        const int savedErrno = errno;
+        const char c = 0;
+        const ssize_t written = ::write(m_signalPipe[1], &c, 1);
+        Q_UNUSED(written);
+        errno = savedErrno;
+    }
+
+    void reapChildren();
+
+    static int m_signalPipe[2];
+    std::unordered_map<pid_t, SpawnedProcess *> m_processes;
+};
+
+int ChildReaper::m_signalPipe[2] = { -1, -1 };
+
+class SpawnedProcess : public Process
+{
+public:
+    SpawnedProcess(quintptr token, QObject *parent) : Process(token, parent) { }
+
+    ~SpawnedProcess()
+    {
+        if (m_pid > 0) {
+            ChildReaper::instance().remove(m_pid);
+            ::kill(m_pid, SIGKILL);
+            waitpid(m_pid, nullptr, 0);
+        }
+        closeChannels();
+    }
+
+    void start(const QString &command, const QStringList &arguments, const QString &workingDir,
+               const EnvironmentBlockPtr &env) override;
+    bool isRunning() const override { return m_pid > 0; }
+    QProcess::ProcessError error() const override { return m_error; }
+    QString errorString() const override { return m_errorString; }
+    int exitCode() const override { return m_exitCode; }
+    QProcess::ExitStatus exitStatus() const override { return m_exitStatus; }
+    QByteArray readAllStandardOutput() override { return takeOutput(m_stdOut.data); }
+    QByteArray readAllStandardError() override { return takeOutput(m_stdErr.data); }
+    void terminate() override { sendSignal(SIGTERM); }
+    void kill() override { sendSignal(SIGKILL); }
+    qint64 cpuTime() const override { return m_cpuTime; }
+    qint64 peakMemoryUsage() const override { return m_peakMemoryUsage; }
+
+    void handleExit(int status, const struct rusage &usage);
+
+private:
+    struct Channel
+    {
+        int fd = -1;
+        QSocketNotifier *notifier = nullptr;
+        QByteArray data;
+    };
+
+    static QByteArray takeOutput(QByteArray &data)
+    {
+        QByteArray output;
+        output.swap(data);
+        return output;
+    }
+
+    void sendSignal(int signal)
+    {
+        if (m_pid > 0)
+            ::kill(m_pid, signal);
+    }
+
+    void setupChannel(Channel &channel, int fd);
+    void readChannel(Channel &channel);
+    void closeChannels();
+    void failToStart(int errorNumber);
+
+    pid_t m_pid = 0;
+    Channel m_stdOut;
+    Channel m_stdErr;
+    QProcess::ProcessError m_error = QProcess::UnknownError;
+    QString m_errorString;
+    int m_exitCode = 0;
+    QProcess::ExitStatus m_exitStatus = QProcess::NormalExit;
+    qint64 m_cpuTime = -1;
+    qint64 m_peakMemoryUsage = -1;
+};
+
+ChildReaper::ChildReaper() : QObject(qApp)
+{
+    if (pipe2(m_signalPipe, O_NONBLOCK | O_CLOEXEC) != 0)
+        qFatal("cannot create signal pipe: %s", std::strerror(errno));
+    const auto notifier = new QSocketNotifier(m_signalPipe[0], QSocketNotifier::Read, this);
+    connect(notifier, &QSocketNotifier::activated, this, &ChildReaper::reapChildren);
+    struct sigaction action;
+    std::memset(&action, 0, sizeof action);
+    action.sa_handler = &ChildReaper::handleSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART | SA_NOCLDSTOP;
+    sigaction(SIGCHLD, &action, nullptr);
+}
+
+void ChildReaper::reapChildren()
+{
+    char buffer[64];
+    while (::read(m_signalPipe[0], buffer, sizeof buffer) > 0)
+        ;
+    struct ExitedProcess
+    {
+        SpawnedProcess *process;
+        int status;
+        struct rusage usage;
+    };
+    std::vector<ExitedProcess> exitedProcesses;
+    for (auto it = m_processes.begin(); it != m_processes.end();) {
+        // Unlike getrusage(RUSAGE_CHILDREN), wait4() reports the resources of exactly
+        // this child (including its own reaped descendants).
+        ExitedProcess exitedProcess;
+        if (wait4(it->first, &exitedProcess.status, WNOHANG, &exitedProcess.usage) == it->first) {
+            exitedProcess.process = it->second;
+            exitedProcesses.push_back(exitedProcess);
+            it = m_processes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Emitting finished() can lead to new processes being registered, so do it only after
+    // we are done iterating.
+    for (const ExitedProcess &exitedProcess : exitedProcesses)
+        exitedProcess.process->handleExit(exitedProcess.status, exitedProcess.usage);
+}
+
+void SpawnedProcess::start(const QString &command, const QStringList &arguments,
+                           const QString &workingDir, const EnvironmentBlockPtr &env)
+{
+    m_error = QProcess::UnknownError;
+    m_errorString.clear();
+    m_exitCode = 0;
+    m_exitStatus = QProcess::NormalExit;
+    m_cpuTime = -1;
+    m_peakMemoryUsage = -1;
+    m_stdOut.data.clear();
+    m_stdErr.data.clear();
+
+    QString program = command;
+    if (!program.contains(QLatin1Char('/'))) {
+        const QString lookupPath = QString::fromLocal8Bit(qgetenv("PATH"));
+        program = QStandardPaths::findExecutable(command,
+                                                 lookupPath.split(QLatin1Char(':'),
+                                                                  QString::SkipEmptyParts));
+        if (program.isEmpty()) {
+            failToStart(ENOENT);
+            return;
+        }
+    }
+
+    int stdOutPipe[2];
+    int stdErrPipe[2];
+    if (pipe2(stdOutPipe, O_CLOEXEC) != 0) {
+        failToStart(errno);
+        return;
+    }
+    if (pipe2(stdErrPipe, O_CLOEXEC) != 0) {
+        const int errorNumber = errno;
+        ::close(stdOutPipe[0]);
+        ::close(stdOutPipe[1]);
+        failToStart(errorNumber);
+        return;
+    }
+
+    const QByteArray encodedProgram = program.toLocal8Bit();
+    const QByteArray encodedWorkingDir = workingDir.toLocal8Bit();
+    std::vector<QByteArray> encodedArguments;
+    encodedArguments.reserve(arguments.size() + 1);
+    encodedArguments.push_back(encodedProgram);
+    for (const QString &argument : arguments)
+        encodedArguments.push_back(argument.toLocal8Bit());
+    std::vector<char *> argv;
+    argv.reserve(encodedArguments.size() + 1);
+    for (QByteArray &argument : encodedArguments)
+        argv.push_back(argument.data());
+    argv.push_back(nullptr);
+
+    posix_spawn_file_actions_t fileActions;
+    posix_spawn_file_actions_init(&fileActions);
+    posix_spawn_file_actions_addopen(&fileActions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    posix_spawn_file_actions_adddup2(&fileActions, stdOutPipe[1], STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&fileActions, stdErrPipe[1], STDERR_FILENO);
+    if (!encodedWorkingDir.isEmpty())
+        posix_spawn_file_actions_addchdir_np(&fileActions, encodedWorkingDir.constData());
+
+    // Our own signal setup must not leak into the child.
+    posix_spawnattr_t attributes;
+    posix_spawnattr_init(&attributes);
+    sigset_t signals;
+    sigemptyset(&signals);
+    posix_spawnattr_setsigmask(&attributes, &signals);
+    sigaddset(&signals, SIGPIPE);
+    posix_spawnattr_setsigdefault(&attributes, &signals);
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF);
+
+    ChildReaper &reaper = ChildReaper::instance();
+    pid_t pid;
+    const int spawnResult = posix_spawn(&pid, encodedProgram.constData(), &fileActions,
+                                        &attributes, argv.data(), env->envp());
+    posix_spawnattr_destroy(&attributes);
+    posix_spawn_file_actions_destroy(&fileActions);
+    ::close(stdOutPipe[1]);
+    ::close(stdErrPipe[1]);
+    if (spawnResult != 0) {
+        ::close(stdOutPipe[0]);
+        ::close(stdErrPipe[0]);
+        failToStart(spawnResult);
+        return;
+    }
+
+    m_pid = pid;
+    setupChannel(m_stdOut, stdOutPipe[0]);
+    setupChannel(m_stdErr, stdErrPipe[0]);
+    reaper.add(pid, this);
+}
+
+void SpawnedProcess::handleExit(int status, const struct rusage &usage)
+{
+    m_pid = 0;
+    m_cpuTime = (qint64(usage.ru_utime.tv_sec) + usage.ru_stime.tv_sec) * 1000
+            + (qint64(usage.ru_utime.tv_usec) + usage.ru_stime.tv_usec) / 1000;
+    m_peakMemoryUsage = qint64(usage.ru_maxrss) * 1024; // Reported in kilobytes on Linux.
+    readChannel(m_stdOut);
+    readChannel(m_stdErr);
+    closeChannels();
+    if (WIFEXITED(status)) {
+        m_exitCode = WEXITSTATUS(status);
+        m_exitStatus = QProcess::NormalExit;
+    } else {
+        m_exitCode = WTERMSIG(status); // Like QProcess.
+        m_exitStatus = QProcess::CrashExit;
+        m_error = QProcess::Crashed;
+        m_errorString = QLatin1String("Process crashed");
+    }
+    emit finished();
+}
+
+void SpawnedProcess::setupChannel(Channel &channel, int fd)
+{
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    channel.fd = fd;
+    channel.notifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+    connect(channel.notifier, &QSocketNotifier::activated,
+            this, [this, &channel] { readChannel(channel); });
+}
+
+void SpawnedProcess::readChannel(Channel &channel)
+{
+    if (channel.fd == -1)
+        return;
+    char buffer[16384];
+    while (true) {
+        const ssize_t count = ::read(channel.fd, buffer, sizeof buffer);
+        if (count > 0) {
+            channel.data.append(buffer, count);
+            continue;
+        }
+        if (count == -1 && errno == EINTR)
+            continue;
+        if (count == 0) {
+            // The child (and all its descendants) have closed the channel.
+            channel.notifier->setEnabled(false);
+        }
+        return;
+    }
+}
+
+void SpawnedProcess::closeChannels()
+{
+    for (Channel * const channel : { &m_stdOut, &m_stdErr }) {
+        if (channel->fd == -1)
+            continue;
+        delete channel->notifier;
+        channel->notifier = nullptr;
+        ::close(channel->fd);
+        channel->fd = -1;
+    }
+}
+
+void SpawnedProcess::failToStart(int errorNumber)
+{
+    m_error = QProcess::FailedToStart;
+    m_errorString = QString::fromLatin1("Process failed to start: %1")
+            .arg(QString::fromLocal8Bit(std::strerror(errorNumber)));
+
+    // Like QProcess, report the error asynchronously.
+    QTimer::singleShot(0, this, &Process::failedToStart);
+}
+
+#endif // QBS_HAS_SPAWN_CHDIR
+
+Process *Process::create(quintptr token, QObject *parent)
+{
+#ifdef QBS_HAS_SPAWN_CHDIR
+    return new SpawnedProcess(token, parent);
+#else
+    return new QtProcess(token, parent);
+#endif
+}
+
+} // namespace Internal
+} // namespace qbs
@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QBS_LAUNCHERPROCESS_H
+#define QBS_LAUNCHERPROCESS_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qprocess.h>
+#include <QtCore/qstringlist.h>
+
+#include <memory>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
+namespace qbs {
+namespace Internal {
+
+// An environment that the client has sent once and then refers to by id. The encoded form
+// needed for spawning processes is computed only once.
+class EnvironmentBlock
+{
+    Q_DISABLE_COPY(EnvironmentBlock)
+public:
+    explicit EnvironmentBlock(const QStringList &entries);
+    EnvironmentBlock(EnvironmentBlock &&) = delete; // m_pointers points into m_encodedEntries.
+    EnvironmentBlock &operator=(EnvironmentBlock &&) = delete;
+
+    const QStringList &entries() const { return m_entries; }
+    char * const *envp() const { return m_pointers.data(); }
+
+private:
+    QStringList m_entries;
+    std::vector<QByteArray> m_encodedEntries;
+    std::vector<char *> m_pointers;
+};
+using EnvironmentBlockPtr = std::shared_ptr<const EnvironmentBlock>;
+
+class Process : public QObject
+{
+    Q_OBJECT
+public:
+    static Process *create(quintptr token, QObject *parent);
+
+    virtual void start(const QString &command, const QStringList &arguments,
+                       const QString &workingDir, const EnvironmentBlockPtr &env) = 0;
+    virtual bool isRunning() const = 0;
+    virtual QProcess::ProcessError error() const = 0;
+    virtual QString errorString() const = 0;
+    virtual int exitCode() const = 0;
+    virtual QProcess::ExitStatus exitStatus() const = 0;
+    virtual QByteArray readAllStandardOutput() = 0;
+    virtual QByteArray readAllStandardError() = 0;
+    virtual void terminate() = 0;
+    virtual void kill() = 0;
+
+    // The resources used by the finished process and its descendants, negative if unknown.
+    virtual qint64 cpuTime() const { return -1; } // In milliseconds.
+    virtual qint64 peakMemoryUsage() const { return -1; } // In bytes.
+
+    void cancel();
+    void stopStopProcedure();
+
+    quintptr token() const { return m_token; }
+
+signals:
+    void failedToStart();
+    void finished();
+    void failedToStop();
+
+protected:
+    Process(quintptr token, QObject *parent);
+
+private:
+    const quintptr m_token;
+    QTimer * const m_stopTimer;
+    enum class StopState { Inactive, Terminating, Killing } m_stopState = StopState::Inactive;
+};
+
+} // namespace Internal
+} // namespace qbs
+
+#endif // Include guard
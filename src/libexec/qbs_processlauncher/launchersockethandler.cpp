@@ -40,63 +40,14 @@
 #include "launchersockethandler.h"
 
 #include "launcherlogging.h"
+#include "launcherprocess.h"
 
 #include <QtCore/qcoreapplication.h>
-#include <QtCore/qprocess.h>
-#include <QtCore/qtimer.h>
 #include <QtNetwork/qlocalsocket.h>
 
 namespace qbs {
 namespace Internal {
 
-class Process : public QProcess
-{
-    Q_OBJECT
-public:
-    Process(quintptr token, QObject *parent = nullptr) :
-        QProcess(parent), m_token(token), m_stopTimer(new QTimer(this))
-    {
-        m_stopTimer->setSingleShot(true);
-        connect(m_stopTimer, &QTimer::timeout, this, &Process::cancel);
-    }
-
-    void cancel()
-    {
-        switch (m_stopState) {
-        case StopState::Inactive:
-            m_stopState = StopState::Terminating;
-            m_stopTimer->start(3000);
-            terminate();
-            break;
-        case StopState::Terminating:
-            m_stopState = StopState::Killing;
-            m_stopTimer->start(3000);
-            kill();
-            break;
-        case StopState::Killing:
-            m_stopState = StopState::Inactive;
-            emit failedToStop();
-            break;
-        }
-    }
-
-    void stopStopProcedure()
-    {
-        m_stopState = StopState::Inactive;
-        m_stopTimer->stop();
-    }
-
-    quintptr token() const { return m_token; }
-
-signals:
-    void failedToStop();
-
-private:
-    const quintptr m_token;
-    QTimer * const m_stopTimer;
-    enum class StopState { Inactive, Terminating, Killing } m_stopState = StopState::Inactive;
-};
-
 LauncherSocketHandler::LauncherSocketHandler(const QString &serverPath, QObject *parent)
     : QObject(parent),
       m_serverPath(serverPath),
@@ -138,6 +89,9 @@ void LauncherSocketHandler::handleSocketData()
         return;
     }
     switch (m_packetParser.type()) {
+    case LauncherPacketType::SetEnvironment:
+        handleSetEnvironmentPacket();
+        break;
     case LauncherPacketType::StartProcess:
         handleStartPacket();
         break;
@@ -167,7 +121,7 @@ void LauncherSocketHandler::handleSocketError()
 void LauncherSocketHandler::handleSocketClosed()
 {
     for (auto it = m_processes.cbegin(); it != m_processes.cend(); ++it) {
-        if (it.value()->state() != QProcess::NotRunning) {
+        if (it.value()->isRunning()) {
             logWarn("client closed connection while process still running");
             break;
         }
@@ -179,8 +133,6 @@ void LauncherSocketHandler::handleSocketClosed()
 void LauncherSocketHandler::handleProcessError()
 {
     Process * proc = senderProcess();
-    if (proc->error() != QProcess::FailedToStart)
-        return;
     proc->stopStopProcedure();
     ProcessErrorPacket packet(proc->token());
     packet.error = proc->error();
@@ -199,6 +151,8 @@ void LauncherSocketHandler::handleProcessFinished()
     packet.exitStatus = proc->exitStatus();
     packet.stdErr = proc->readAllStandardError();
     packet.stdOut = proc->readAllStandardOutput();
+    packet.cpuTime = proc->cpuTime();
+    packet.peakMemoryUsage = proc->peakMemoryUsage();
     sendPacket(packet);
 }
 
@@ -223,16 +177,31 @@ void LauncherSocketHandler::handleStartPacket()
     Process *& process = m_processes[m_packetParser.token()];
     if (!process)
         process = setupProcess(m_packetParser.token());
-    if (process->state() != QProcess::NotRunning) {
+    if (process->isRunning()) {
         logWarn("got start request while process was running");
         return;
     }
     const auto packet = LauncherPacket::extractPacket<StartProcessPacket>(
                 m_packetParser.token(),
                 m_packetParser.packetData());
-    process->setEnvironment(packet.env);
-    process->setWorkingDirectory(packet.workingDir);
-    process->start(packet.command, packet.arguments);
+    const EnvironmentBlockPtr env = m_environments.value(packet.environmentId);
+    if (!env) {
+        logWarn("got start request for unknown environment");
+        ProcessErrorPacket errorPacket(packet.token);
+        errorPacket.error = QProcess::FailedToStart;
+        errorPacket.errorString = QLatin1String("Internal error: unknown environment");
+        sendPacket(errorPacket);
+        return;
+    }
+    process->start(packet.command, packet.arguments, packet.workingDir, env);
+}
+
+void LauncherSocketHandler::handleSetEnvironmentPacket()
+{
+    const auto packet = LauncherPacket::extractPacket<SetEnvironmentPacket>(
+                m_packetParser.token(),
+                m_packetParser.packetData());
+    m_environments.insert(packet.token, std::make_shared<const EnvironmentBlock>(packet.env));
 }
 
 void LauncherSocketHandler::handleStopPacket()
@@ -242,7 +211,7 @@ void LauncherSocketHandler::handleStopPacket()
         logWarn("got stop request for unknown process");
         return;
     }
-    if (process->state() == QProcess::NotRunning) {
+    if (!process->isRunning()) {
         // This can happen if the process finishes on its own at about the same time the client
         // sends the request.
         logDebug("got stop request when process was not running");
@@ -256,7 +225,7 @@ void LauncherSocketHandler::handleShutdownPacket()
     logDebug("got shutdown request, closing down");
     for (auto it = m_processes.cbegin(); it != m_processes.cend(); ++it) {
         it.value()->disconnect();
-        if (it.value()->state() != QProcess::NotRunning) {
+        if (it.value()->isRunning()) {
             logWarn("got shutdown request while process was running");
             it.value()->terminate();
         }
@@ -272,11 +241,9 @@ void LauncherSocketHandler::sendPacket(const LauncherPacket &packet)
 
 Process *LauncherSocketHandler::setupProcess(quintptr token)
 {
-    const auto p = new Process(token, this);
-    connect(p, static_cast<void (QProcess::*)(QProcess::ProcessError)>(&QProcess::error),
-            this, &LauncherSocketHandler::handleProcessError);
-    connect(p, static_cast<void (QProcess::*)(int)>(&QProcess::finished),
-            this, &LauncherSocketHandler::handleProcessFinished);
+    const auto p = Process::create(token, this);
+    connect(p, &Process::failedToStart, this, &LauncherSocketHandler::handleProcessError);
+    connect(p, &Process::finished, this, &LauncherSocketHandler::handleProcessFinished);
     connect(p, &Process::failedToStop, this, &LauncherSocketHandler::handleStopFailure);
     return p;
 }
@@ -288,5 +255,3 @@ Process *LauncherSocketHandler::senderProcess() const
 
 } // namespace Internal
 } // namespace qbs
-
-#include <launchersockethandler.moc>
@@ -50,8 +50,11 @@ QT_BEGIN_NAMESPACE
 class QLocalSocket;
 QT_END_NAMESPACE
 
+#include <memory>
+
 namespace qbs {
 namespace Internal {
+class EnvironmentBlock;
 class Process;
 
 class LauncherSocketHandler : public QObject
@@ -71,6 +74,7 @@ private:
     void handleProcessFinished();
     void handleStopFailure();
 
+    void handleSetEnvironmentPacket();
     void handleStartPacket();
     void handleStopPacket();
     void handleShutdownPacket();
@@ -84,6 +88,7 @@ private:
     QLocalSocket * const m_socket;
     PacketParser m_packetParser;
     QHash<quintptr, Process *> m_processes;
+    QHash<quintptr, std::shared_ptr<const EnvironmentBlock>> m_environments;
 };
 
 } // namespace Internal
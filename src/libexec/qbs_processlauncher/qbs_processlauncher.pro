@@ -11,11 +11,13 @@ INCLUDEPATH += $$TOOLS_DIR
 
 HEADERS += \
     launcherlogging.h \
+    launcherprocess.h \
     launchersockethandler.h \
     $$TOOLS_DIR/launcherpackets.h
 
 SOURCES += \
     launcherlogging.cpp \
+    launcherprocess.cpp \
     launchersockethandler.cpp \
     processlauncher-main.cpp \
     $$TOOLS_DIR/launcherpackets.cpp
@@ -60,7 +60,9 @@ using namespace CPlusPlus;
 #include <QtCore/qlist.h>
 #include <QtCore/qstring.h>
 
+#include <algorithm>
 #include <cstring>
+#include <initializer_list>
 #include <memory>
 
 struct ScanResult
@@ -133,8 +135,27 @@ public:
     }
 };
 
-static void scanCppFile(void *opaq, CPlusPlus::Lexer &yylex, bool scanForFileTags,
-                        bool scanForDependencies)
+// Returns the offset of the last occurrence of any of the given words in the content, or -1.
+// The content is searched from the end, so only the part after that occurrence gets visited.
+static int lastOccurrence(const char *begin, const char *end,
+                          std::initializer_list<QLatin1Literal> words)
+{
+    bool isFirstChar[256] = { false };
+    for (const QLatin1Literal &word : words)
+        isFirstChar[static_cast<unsigned char>(*word.data())] = true;
+    for (const char *p = end; p-- != begin;) {
+        if (!isFirstChar[static_cast<unsigned char>(*p)])
+            continue;
+        for (const QLatin1Literal &word : words) {
+            if (end - p >= word.size() && memcmp(p, word.data(), word.size()) == 0)
+                return static_cast<int>(p - begin);
+        }
+    }
+    return -1;
+}
+
+static void scanCppFile(void *opaq, CPlusPlus::Lexer &yylex, size_t contentLength,
+                        bool scanForFileTags, bool scanForDependencies)
 {
     const QLatin1Literal includeLiteral("include");
     const QLatin1Literal importLiteral("import");
@@ -149,9 +170,29 @@ static void scanCppFile(void *opaq, CPlusPlus::Lexer &yylex, bool scanForFileTag
     Token oldTk;
     ScanResult scanResult;
 
+    // Tokens are matched byte-wise against the literals above, so no relevant token can
+    // start behind the last place where one of them appears verbatim. Stop lexing there;
+    // in particular, files without any such place do not need to be lexed at all.
+    const char * const contentEnd = opaque->fileContent + contentLength;
+    int lastRelevantOffset = -1;
+    if (scanForDependencies) {
+        lastRelevantOffset = lastOccurrence(opaque->fileContent, contentEnd,
+                                            { includeLiteral, importLiteral });
+    }
+    if (scanForFileTags) {
+        lastRelevantOffset = std::max(lastRelevantOffset,
+                lastOccurrence(opaque->fileContent, contentEnd,
+                               { qobjectLiteral, qgadgetLiteral, qnamespaceLiteral,
+                                 pluginMetaDataLiteral }));
+    }
+    if (lastRelevantOffset == -1)
+        return;
+
     yylex(&tk);
 
     while (tk.isNot(T_EOF_SYMBOL)) {
+        if (tk.begin() > static_cast<unsigned int>(lastRelevantOffset))
+            break;
         if (tk.newline() && tk.is(T_POUND)) {
             yylex(&tk);
 
@@ -259,7 +300,8 @@ static void *openScanner(const unsigned short *filePath, const char *fileTags, i
     }
 
     CPlusPlus::Lexer lex(opaque->fileContent, opaque->fileContent + mapl);
-    scanCppFile(opaque.get(), lex, flags & ScanForFileTagsFlag, flags & ScanForDependenciesFlag);
+    scanCppFile(opaque.get(), lex, mapl, flags & ScanForFileTagsFlag,
+                flags & ScanForDependenciesFlag);
     return opaque.release();
 }
 
@@ -316,7 +358,7 @@ ScannerPlugin includeScanner =
     closeScanner,
     next,
     additionalFileTags,
-    ScannerUsesCppIncludePaths | ScannerRecursiveDependencies
+    ScannerUsesCppIncludePaths | ScannerRecursiveDependencies | ScannerThreadSafe
 };
 
 ScannerPlugin *cppScanners[] = { &includeScanner, NULL };
@@ -185,7 +185,7 @@ ScannerPlugin qrcScanner =
     closeScannerQrc,
     nextQrc,
     additionalFileTagsQrc,
-    NoScannerFlags
+    ScannerThreadSafe
 };
 
 ScannerPlugin *qtScanners[] = {&qrcScanner, NULL};
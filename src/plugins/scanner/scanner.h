@@ -85,7 +85,8 @@ enum ScannerFlags
 {
     NoScannerFlags = 0x00,
     ScannerUsesCppIncludePaths = 0x01,
-    ScannerRecursiveDependencies = 0x02
+    ScannerRecursiveDependencies = 0x02,
+    ScannerThreadSafe = 0x04 // Different handles may be used concurrently.
 };
 
 class ScannerPlugin
@@ -53,6 +53,7 @@
 #include <functional>
 #include <memory>
 #include <regex>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -2916,6 +2917,8 @@ void TestApi::transformerData()
                      QString("artifact1"));
             QCOMPARE(tData.commands().size(), 1);
             QCOMPARE(tData.commands().first().type(), qbs::RuleCommand::JavaScriptCommandType);
+            QVERIFY(tData.commands().first().lastWallTime() >= 0);
+            QVERIFY(tData.commands().first().lastCpuTime() < 0);
         } else {
             secondTransformerFound = true;
             QCOMPARE(tData.inputs().size(), 1);
@@ -2925,6 +2928,8 @@ void TestApi::transformerData()
                      QString("artifact2"));
             QCOMPARE(tData.commands().size(), 1);
             QCOMPARE(tData.commands().first().type(), qbs::RuleCommand::JavaScriptCommandType);
+            QVERIFY(tData.commands().first().lastWallTime() >= 0);
+            QVERIFY(tData.commands().first().lastCpuTime() < 0);
         }
     }
     QVERIFY(firstTransformerFound);
@@ -2963,6 +2968,20 @@ void TestApi::uic()
     VERIFY_NO_ERROR(errorInfo);
 }
 
+void TestApi::wildcardDirectories()
+{
+    const qbs::SetupProjectParameters setupParams
+            = defaultSetupParameters("wildcard-directories");
+    const std::unique_ptr<qbs::SetupProjectJob> job(qbs::Project().setupProject(setupParams,
+                                                                              m_logSink, 0));
+    waitForFinished(job.get());
+    QVERIFY2(!job->error().hasError(), qPrintable(job->error().toString()));
+    const std::set<QString> dirPaths = job->project().wildcardDirectories();
+    QVERIFY(dirPaths.count(setupParams.buildRoot() + "/src") == 1);
+    QVERIFY(dirPaths.count(setupParams.buildRoot() + "/deep") == 1);
+    QVERIFY(dirPaths.count(setupParams.buildRoot() + "/deep/sub") == 1);
+}
+
 
 qbs::ErrorInfo TestApi::doBuildProject(
     const QString &projectFilePath, BuildDescriptionReceiver *buildDescriptionReceiver,
@@ -149,6 +149,7 @@ private slots:
     void transformers();
     void typeChange();
     void uic();
+    void wildcardDirectories();
 
 private:
     qbs::SetupProjectParameters defaultSetupParameters(const QString &projectFileOrDir) const;
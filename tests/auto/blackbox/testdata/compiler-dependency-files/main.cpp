@@ -0,0 +1,10 @@
+#include "header.h"
+
+#if 0
+#include "unused.h"
+#endif
+
+int main()
+{
+    return value();
+}
@@ -0,0 +1 @@
+inline int afterBlockComment() { return 0; }
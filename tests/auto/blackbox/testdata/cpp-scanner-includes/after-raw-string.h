@@ -0,0 +1 @@
+inline int afterRawString() { return 0; }
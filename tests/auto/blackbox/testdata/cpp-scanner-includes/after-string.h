@@ -0,0 +1 @@
+inline int afterString() { return 0; }
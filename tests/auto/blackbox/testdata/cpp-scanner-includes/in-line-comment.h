@@ -0,0 +1 @@
+#error "This file must not be included."
@@ -0,0 +1 @@
+// Included at the very end of main.cpp, without a trailing newline.
@@ -0,0 +1,65 @@
+/*
+ * This comment is long enough to make the scanner skip a good part of the file,
+ * and it mentions the word include a couple of times.
+#include "in-block-comment.h"
+ * Filler line 0 that does not include anything of interest.
+ * Filler line 1 that does not include anything of interest.
+ * Filler line 2 that does not include anything of interest.
+ * Filler line 3 that does not include anything of interest.
+ * Filler line 4 that does not include anything of interest.
+ * Filler line 5 that does not include anything of interest.
+ * Filler line 6 that does not include anything of interest.
+ * Filler line 7 that does not include anything of interest.
+ * Filler line 8 that does not include anything of interest.
+ * Filler line 9 that does not include anything of interest.
+ * Filler line 10 that does not include anything of interest.
+ * Filler line 11 that does not include anything of interest.
+ * Filler line 12 that does not include anything of interest.
+ * Filler line 13 that does not include anything of interest.
+ * Filler line 14 that does not include anything of interest.
+ * Filler line 15 that does not include anything of interest.
+ * Filler line 16 that does not include anything of interest.
+ * Filler line 17 that does not include anything of interest.
+ * Filler line 18 that does not include anything of interest.
+ * Filler line 19 that does not include anything of interest.
+ * Filler line 20 that does not include anything of interest.
+ * Filler line 21 that does not include anything of interest.
+ * Filler line 22 that does not include anything of interest.
+ * Filler line 23 that does not include anything of interest.
+ * Filler line 24 that does not include anything of interest.
+ * Filler line 25 that does not include anything of interest.
+ * Filler line 26 that does not include anything of interest.
+ * Filler line 27 that does not include anything of interest.
+ * Filler line 28 that does not include anything of interest.
+ * Filler line 29 that does not include anything of interest.
+ * Filler line 30 that does not include anything of interest.
+ * Filler line 31 that does not include anything of interest.
+ * Filler line 32 that does not include anything of interest.
+ * Filler line 33 that does not include anything of interest.
+ * Filler line 34 that does not include anything of interest.
+ * Filler line 35 that does not include anything of interest.
+ * Filler line 36 that does not include anything of interest.
+ * Filler line 37 that does not include anything of interest.
+ * Filler line 38 that does not include anything of interest.
+ * Filler line 39 that does not include anything of interest.
+ */
+#include "after-block-comment.h"
+
+static const char * const s = "#include \"in-string.h\" is not an include, and neither is "
+        "this: include \"in-string.h\"";
+
+#include "after-string.h"
+
+static const char * const r = R"delim(a "quoted" include)" and ")delim";
+
+#include "after-raw-string.h"
+
+int main()
+{
+    (void)s;
+    (void)r;
+    return afterBlockComment() + afterString() + afterRawString();
+}
+
+// #include "in-line-comment.h"
+#include "last.h"
\ No newline at end of file
@@ -0,0 +1 @@
+inline int dependencyValue() { return 1; }
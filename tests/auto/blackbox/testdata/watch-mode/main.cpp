@@ -0,0 +1,6 @@
+#include <dependency.h>
+
+int main()
+{
+    return dependencyValue() - 1;
+}
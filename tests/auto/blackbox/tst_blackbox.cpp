@@ -50,7 +50,9 @@
 #include <QtCore/qsettings.h>
 #include <QtCore/qtemporarydir.h>
 #include <QtCore/qtemporaryfile.h>
+#include <QtCore/qthread.h>
 
+#include <algorithm>
 #include <functional>
 #include <regex>
 #include <utility>
@@ -1446,6 +1448,47 @@ void TestBlackbox::versionScript()
     QVERIFY2(globalSymbols.contains("dummyGlobal"), allSymbols.constData());
 }
 
+void TestBlackbox::watchMode()
+{
+    if (!HostOsInfo::isLinuxHost())
+        QSKIP("Watching for file changes is only supported on Linux");
+    QDir::setCurrent(testDataDir + "/watch-mode");
+    QProcess qbs;
+    qbs.setProcessChannelMode(QProcess::MergedChannels);
+    qbs.start(qbsExecutableFilePath,
+              QStringList{"build", "--settings-dir", settings()->baseDirectory(), "-d", ".",
+                          "--watch", "profile:" + profileName()});
+    QVERIFY2(qbs.waitForStarted(), qPrintable(qbs.errorString()));
+    QByteArray output;
+    const auto waitForOutput = [&qbs, &output](const QByteArray &text) {
+        while (!output.contains(text)) {
+            if (!qbs.waitForReadyRead(testTimeoutInMsecs()))
+                return false;
+            output += qbs.readAll();
+        }
+        return true;
+    };
+    const QByteArray waitingMessage = "Waiting for changes...";
+    QVERIFY2(waitForOutput(waitingMessage), output.constData());
+    QVERIFY2(output.contains("compiling main.cpp"), output.constData());
+
+    // The header is not part of the product; only the dependency scanner knows about it.
+    output.clear();
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("include/dependency.h");
+    QVERIFY2(waitForOutput(waitingMessage), output.constData());
+    QVERIFY2(output.contains("compiling main.cpp"), output.constData());
+
+    output.clear();
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("main.cpp");
+    QVERIFY2(waitForOutput(waitingMessage), output.constData());
+    QVERIFY2(output.contains("compiling main.cpp"), output.constData());
+
+    qbs.kill();
+    qbs.waitForFinished();
+}
+
 void TestBlackbox::wholeArchive()
 {
     QDir::setCurrent(testDataDir + "/whole-archive");
@@ -1607,6 +1650,28 @@ void TestBlackbox::concurrentExecutor()
     QVERIFY2(!m_qbsStderr.contains("ASSERT"), m_qbsStderr.constData());
 }
 
+void TestBlackbox::concurrentProbes()
+{
+    QDir::setCurrent(testDataDir + "/concurrent-probes");
+    QCOMPARE(runQbs(QbsRunParameters("resolve", QStringList("--concurrent-probe-execution"))),
+             0);
+    QVERIFY2(m_qbsStdout.contains("results: one, two, one and three"), m_qbsStdout.constData());
+    QCOMPARE(m_qbsStdout.count("running firstProbe"), 1);
+    QCOMPARE(m_qbsStdout.count("running secondProbe"), 1);
+    QCOMPARE(m_qbsStdout.count("running dependentProbe"), 1);
+    if (QThread::idealThreadCount() < 2)
+        QSKIP("Probes cannot overlap on a single core.");
+    const int intervalsIndex = m_qbsStdout.indexOf("intervals: ");
+    QVERIFY2(intervalsIndex != -1, m_qbsStdout.constData());
+    const int intervalsEnd = m_qbsStdout.indexOf('\n', intervalsIndex);
+    const QList<QByteArray> times = m_qbsStdout.mid(intervalsIndex + 11,
+                                                    intervalsEnd - intervalsIndex - 11)
+            .trimmed().split(',');
+    QCOMPARE(times.size(), 4);
+    QVERIFY2(times.at(0).toDouble() < times.at(3).toDouble()
+             && times.at(2).toDouble() < times.at(1).toDouble(), m_qbsStdout.constData());
+}
+
 void TestBlackbox::conditionalExport()
 {
     QDir::setCurrent(testDataDir + "/conditional-export");
@@ -1736,6 +1801,32 @@ void TestBlackbox::cxxLanguageVersion_data()
                             std::make_pair(QString("msvc-new"), QString("/std:"))});
 }
 
+void TestBlackbox::cppScannerIncludes()
+{
+    QDir::setCurrent(testDataDir + "/cpp-scanner-includes");
+    QFETCH(QString, header);
+    QFETCH(bool, isDependency);
+    QCOMPARE(runQbs(), 0);
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch(header);
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(m_qbsStdout.contains("compiling main.cpp") == isDependency,
+             m_qbsStdout.constData());
+}
+
+void TestBlackbox::cppScannerIncludes_data()
+{
+    QTest::addColumn<QString>("header");
+    QTest::addColumn<bool>("isDependency");
+    QTest::newRow("include after block comment") << "after-block-comment.h" << true;
+    QTest::newRow("include after string literal") << "after-string.h" << true;
+    QTest::newRow("include after raw string literal") << "after-raw-string.h" << true;
+    QTest::newRow("include at end of file") << "last.h" << true;
+    QTest::newRow("include in block comment") << "in-block-comment.h" << false;
+    QTest::newRow("include in line comment") << "in-line-comment.h" << false;
+    QTest::newRow("include in string literal") << "in-string.h" << false;
+}
+
 void TestBlackbox::cpuFeatures()
 {
     QDir::setCurrent(testDataDir + "/cpu-features");
@@ -1767,6 +1858,94 @@ void TestBlackbox::cpuFeatures()
     }
 }
 
+void TestBlackbox::contentHashCheck()
+{
+    QDir::setCurrent(testDataDir + "/content-hash-check");
+    const QbsRunParameters params(QStringList("--check-content-hashes"));
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(m_qbsStdout.contains("stripping comments"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("creating final output"), m_qbsStdout.constData());
+
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("input.txt");
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(!m_qbsStdout.contains("stripping comments"), m_qbsStdout.constData());
+    QVERIFY2(!m_qbsStdout.contains("creating final output"), m_qbsStdout.constData());
+
+    // The intermediate file comes out the same, so the second rule must not run.
+    WAIT_FOR_NEW_TIMESTAMP();
+    REPLACE_IN_FILE("input.txt", "# a comment", "# another comment");
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(m_qbsStdout.contains("stripping comments"), m_qbsStdout.constData());
+    QVERIFY2(!m_qbsStdout.contains("creating final output"), m_qbsStdout.constData());
+
+    WAIT_FOR_NEW_TIMESTAMP();
+    REPLACE_IN_FILE("input.txt", "data", "other data");
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(m_qbsStdout.contains("stripping comments"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("creating final output"), m_qbsStdout.constData());
+
+    // An input that changes while the command is running must get processed again,
+    // even though its new content was already there when the command had finished.
+    WAIT_FOR_NEW_TIMESTAMP();
+    REPLACE_IN_FILE("input.txt", "other data", "more data");
+    QFile markerFile("edit-input");
+    QVERIFY(markerFile.open(QIODevice::WriteOnly));
+    markerFile.close();
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(m_qbsStdout.contains("stripping comments"), m_qbsStdout.constData());
+    QVERIFY(markerFile.remove());
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(m_qbsStdout.contains("stripping comments"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("creating final output"), m_qbsStdout.constData());
+    QFile finalFile(relativeProductBuildDir("content-hash-check") + "/final.txt");
+    QVERIFY2(finalFile.open(QIODevice::ReadOnly), qPrintable(finalFile.errorString()));
+    QVERIFY2(finalFile.readAll().contains("edited data"), qPrintable(finalFile.fileName()));
+    finalFile.close();
+
+    // Without the option, timestamps are all that counts.
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("input.txt");
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(m_qbsStdout.contains("stripping comments"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("creating final output"), m_qbsStdout.constData());
+}
+
+void TestBlackbox::crashingCommand()
+{
+    if (!HostOsInfo::isAnyUnixHost())
+        QSKIP("only applies on Unix");
+
+    // The exit code of a process killed by a signal is the signal number, like in QProcess.
+    QDir::setCurrent(testDataDir + "/crashing-command");
+    QbsRunParameters params;
+    params.expectFailure = true;
+    QVERIFY(runQbs(params) != 0);
+    QVERIFY2(m_qbsStdout.contains("crashing"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStderr.contains("Process failed with exit code 9."),
+             m_qbsStderr.constData());
+    QVERIFY(!regularFileExists(relativeProductBuildDir("crashing-command")
+                               + "/crash-output.txt"));
+}
+
+void TestBlackbox::criticalPathScheduling()
+{
+    QDir::setCurrent(testDataDir + "/critical-path-scheduling");
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(m_qbsStdout.contains("running long"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("running short"), m_qbsStdout.constData());
+
+    // The second build knows how long the commands take and must start the long one first.
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("long.txt");
+    touch("short.txt");
+    QCOMPARE(runQbs(QStringList{"--critical-path-scheduling", "--jobs", "1"}), 0);
+    const int longIndex = m_qbsStdout.indexOf("running long");
+    const int shortIndex = m_qbsStdout.indexOf("running short");
+    QVERIFY2(longIndex != -1 && shortIndex != -1, m_qbsStdout.constData());
+    QVERIFY2(longIndex < shortIndex, m_qbsStdout.constData());
+}
+
 void TestBlackbox::renameDependency()
 {
     QDir::setCurrent(testDataDir + "/renameDependency");
@@ -2215,6 +2394,21 @@ void TestBlackbox::recursiveWildcards()
     QVERIFY2(outputFile.open(QIODevice::ReadOnly), qPrintable(outputFile.errorString()));
     QCOMPARE(outputFile.readAll(), QByteArray("file1.txtfile2.txt"));
     outputFile.close();
+
+    // A hidden file changes the directory timestamp, but not the set of matching files.
+    // On Windows, a leading dot does not make a file hidden.
+    if (!HostOsInfo::isWindowsHost()) {
+        WAIT_FOR_NEW_TIMESTAMP();
+        QFile hiddenFile("dir/subdir/.hidden.txt");
+        QVERIFY2(hiddenFile.open(QIODevice::WriteOnly), qPrintable(hiddenFile.errorString()));
+        hiddenFile.close();
+        QCOMPARE(runQbs(QbsRunParameters("install")), 0);
+        QVERIFY2(!m_qbsStdout.contains("Resolving"), m_qbsStdout.constData());
+        QCOMPARE(runQbs(QbsRunParameters("install")), 0);
+        QVERIFY2(!m_qbsStdout.contains("Resolving"), m_qbsStdout.constData());
+        QVERIFY2(hiddenFile.remove(), qPrintable(hiddenFile.errorString()));
+    }
+
     WAIT_FOR_NEW_TIMESTAMP();
     QFile newFile("dir/subdir/file3.txt");
     QVERIFY2(newFile.open(QIODevice::WriteOnly), qPrintable(newFile.errorString()));
@@ -2837,6 +3031,50 @@ void TestBlackbox::preventFloatingPointValues()
     QVERIFY2(m_qbsStdout.contains("version: 1.50"), m_qbsStdout.constData());
 }
 
+void TestBlackbox::probeCache()
+{
+    QDir::setCurrent(testDataDir + "/probe-cache");
+    qbs::Settings settings(QDir::currentPath() + "/settings-dir");
+    settings.setValue("preferences.probeCacheDirectory", QDir::currentPath() + "/probe-cache-dir");
+    settings.sync();
+    QbsRunParameters params("resolve");
+    params.settingsDir = settings.baseDirectory();
+    params.profile = "none";
+
+    // The first build directory runs the probe, the second one re-uses its result.
+    params.buildDirectory = "build1";
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(m_qbsStdout.contains("running probe"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("file exists: false"), m_qbsStdout.constData());
+    params.buildDirectory = "build2";
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(!m_qbsStdout.contains("running probe"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("file exists: false"), m_qbsStdout.constData());
+
+    // A changed file system query invalidates the cached result.
+    touch("data.txt");
+    params.buildDirectory = "build3";
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(m_qbsStdout.contains("running probe"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("file exists: true"), m_qbsStdout.constData());
+
+    // So does a changed environment variable.
+    params.environment.insert("QBS_PROBE_CACHE_TEST_VAR", "value");
+    params.buildDirectory = "build4";
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(m_qbsStdout.contains("running probe"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("env value: value"), m_qbsStdout.constData());
+    params.buildDirectory = "build5";
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(!m_qbsStdout.contains("running probe"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("env value: value"), m_qbsStdout.constData());
+
+    // Probe execution can still be forced.
+    params.arguments << "--force-probe-execution";
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(m_qbsStdout.contains("running probe"), m_qbsStdout.constData());
+}
+
 void TestBlackbox::probeChangeTracking()
 {
     QDir::setCurrent(testDataDir + "/probe-change-tracking");
@@ -3986,6 +4224,32 @@ void TestBlackbox::compilerDefinesByLanguage()
     QCOMPARE(runQbs(params), 0);
 }
 
+void TestBlackbox::compilerDependencyFiles()
+{
+    const SettingsPtr s = settings();
+    const Profile profile(profileName(), s.get());
+    if (!profile.value("qbs.toolchain").toStringList().contains("gcc"))
+        QSKIP("Need GCC-like compiler to run this test");
+    QDir::setCurrent(testDataDir + "/compiler-dependency-files");
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(m_qbsStdout.contains("compiling main.cpp"), m_qbsStdout.constData());
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(!m_qbsStdout.contains("compiling main.cpp"), m_qbsStdout.constData());
+
+    // The C++ scanner would consider this header, but the compiler does not read it.
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("unused.h");
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(!m_qbsStdout.contains("compiling main.cpp"), m_qbsStdout.constData());
+
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("header.h");
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(m_qbsStdout.contains("compiling main.cpp"), m_qbsStdout.constData());
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(!m_qbsStdout.contains("compiling main.cpp"), m_qbsStdout.constData());
+}
+
 void TestBlackbox::jsExtensionsFile()
 {
     QDir::setCurrent(testDataDir + "/jsextensions-file");
@@ -6482,6 +6746,78 @@ void TestBlackbox::buildDataOfDisabledProduct()
     QVERIFY2(m_qbsStdout.contains("compiling test.cpp"), m_qbsStdout.constData());
 }
 
+void TestBlackbox::qbsSession()
+{
+    QDir::setCurrent(testDataDir + "/qbs-session");
+    QProcess session;
+    session.start(qbsExecutableFilePath,
+                  QStringList{"session", "--settings-dir", settings()->baseDirectory()});
+    QVERIFY2(session.waitForStarted(), qPrintable(session.errorString()));
+    const auto sendRequest = [&session](const QJsonObject &request) {
+        session.write(QJsonDocument(request).toJson(QJsonDocument::Compact) + '\n');
+    };
+    QList<QJsonObject> receivedPackets;
+    const auto receivePacket = [&session, &receivedPackets](const QString &type) {
+        while (true) {
+            while (!session.canReadLine()) {
+                if (!session.waitForReadyRead(60000))
+                    return QJsonObject();
+            }
+            const QJsonObject packet = QJsonDocument::fromJson(session.readLine()).object();
+            receivedPackets << packet;
+            if (packet.value("type").toString() == type)
+                return packet;
+        }
+    };
+    const auto commandDescriptionCount = [&receivedPackets] {
+        return std::count_if(receivedPackets.cbegin(), receivedPackets.cend(),
+                             [](const QJsonObject &packet) {
+            return packet.value("type").toString() == "command-description";
+        });
+    };
+    QCOMPARE(receivePacket("hello").value("api-level").toInt(), 1);
+
+    sendRequest(QJsonObject{{"type", "resolve-project"},
+                            {"project-file-path", QDir::currentPath() + "/qbs-session.qbs"},
+                            {"build-root", QDir::currentPath()},
+                            {"configuration-name", relativeBuildDir()},
+                            {"top-level-profile", profileName()}});
+    QJsonObject reply = receivePacket("project-resolved");
+    QVERIFY2(!reply.isEmpty() && !reply.contains("error"),
+             QJsonDocument(reply).toJson().constData());
+    QCOMPARE(reply.value("products").toArray(), QJsonArray{"p"});
+
+    sendRequest(QJsonObject{{"type", "build-project"}});
+    reply = receivePacket("project-built");
+    QVERIFY2(!reply.isEmpty() && !reply.contains("error"),
+             QJsonDocument(reply).toJson().constData());
+    QCOMPARE(commandDescriptionCount(), 1);
+    const QString outputFilePath = relativeProductBuildDir("p") + "/out.txt";
+    QVERIFY(regularFileExists(outputFilePath));
+
+    // The second build works on the project in memory and has nothing to do.
+    sendRequest(QJsonObject{{"type", "build-project"}});
+    reply = receivePacket("project-built");
+    QVERIFY2(!reply.isEmpty() && !reply.contains("error"),
+             QJsonDocument(reply).toJson().constData());
+    QCOMPARE(commandDescriptionCount(), 1);
+
+    sendRequest(QJsonObject{{"type", "build-project"}, {"products", QJsonArray{"q"}}});
+    reply = receivePacket("project-built");
+    QVERIFY(reply.contains("error"));
+
+    sendRequest(QJsonObject{{"type", "clean-project"}});
+    reply = receivePacket("project-cleaned");
+    QVERIFY2(!reply.isEmpty() && !reply.contains("error"),
+             QJsonDocument(reply).toJson().constData());
+    QVERIFY(!regularFileExists(outputFilePath));
+
+    sendRequest(QJsonObject{{"type", "quit"}});
+    QVERIFY(session.waitForFinished());
+    QCOMPARE(session.exitStatus(), QProcess::NormalExit);
+    QCOMPARE(session.exitCode(), 0);
+}
+
 void TestBlackbox::qbsVersion()
 {
     const auto v = qbs::LanguageInfo::qbsVersion();
@@ -73,14 +73,21 @@ private slots:
     void combinedSources();
     void commandFile();
     void compilerDefinesByLanguage();
+    void compilerDependencyFiles();
     void concurrentExecutor();
+    void concurrentProbes();
     void conditionalExport();
     void conditionalFileTagger();
     void configure();
     void conflictingArtifacts();
+    void contentHashCheck();
     void cxxLanguageVersion();
     void cxxLanguageVersion_data();
+    void cppScannerIncludes();
+    void cppScannerIncludes_data();
     void cpuFeatures();
+    void crashingCommand();
+    void criticalPathScheduling();
     void dependenciesProperty();
     void dependencyProfileMismatch();
     void deprecatedProperty();
@@ -208,6 +215,7 @@ private slots:
     void pluginDependency();
     void precompiledAndPrefixHeaders();
     void preventFloatingPointValues();
+    void probeCache();
     void probeChangeTracking();
     void probeProperties();
     void probesAndShadowProducts();
@@ -226,6 +234,7 @@ private slots:
     void protobuf();
     void pseudoMultiplexing();
     void qbsConfig();
+    void qbsSession();
     void qbsVersion();
     void qtBug51237();
     void radAfterIncompleteBuild();
@@ -288,6 +297,7 @@ private slots:
     void versionCheck();
     void versionCheck_data();
     void versionScript();
+    void watchMode();
     void wholeArchive();
     void wholeArchive_data();
     void wildCardsAndRules();
@@ -65,6 +65,9 @@ private slots:
         args << "--changed-files" << "foo,bar" << m_fileArgs;
         args << "--check-timestamps";
         args << "--check-outputs";
+        args << "--critical-path-scheduling";
+        args << "--check-content-hashes";
+        args << "--concurrent-probe-execution";
         CommandLineParser parser;
 
         QVERIFY(parser.parseCommandLine(args));
@@ -75,6 +78,9 @@ private slots:
         QVERIFY(parser.buildOptions(QString()).keepGoing());
         QVERIFY(parser.forceTimestampCheck());
         QVERIFY(parser.forceOutputCheck());
+        QVERIFY(parser.buildOptions(QString()).criticalPathScheduling());
+        QVERIFY(parser.buildOptions(QString()).contentHashCheck());
+        QVERIFY(parser.concurrentProbeExecution());
         QVERIFY(!parser.logTime());
         QCOMPARE(parser.buildConfigurations().size(), 1);
 
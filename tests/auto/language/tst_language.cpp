@@ -43,6 +43,7 @@
 
 #include "../shared.h"
 
+#include <language/astcache.h>
 #include <language/evaluator.h>
 #include <language/filecontext.h>
 #include <language/identifiersearch.h>
@@ -214,6 +215,29 @@ void TestLanguage::additionalProductTypes()
     QCOMPARE(exceptionCaught, false);
 }
 
+void TestLanguage::astCache()
+{
+    const FileTime oldTime = FileTime::oldestTime();
+    const FileTime newTime = FileTime::currentTime();
+    const auto parsedFile = [] { return std::make_shared<const ParsedFile>(); };
+    ASTCache cache(2);
+    const ParsedFileConstPtr a = parsedFile();
+    cache.insert("a.qbs", oldTime, a);
+    QVERIFY(cache.value("a.qbs", oldTime) == a);
+    QVERIFY(!cache.value("a.qbs", newTime));
+    QVERIFY(!cache.value("a.qbs", FileTime()));
+    QVERIFY(!cache.value("b.qbs", oldTime));
+
+    // The entry that was used least recently goes first.
+    cache.insert("b.qbs", oldTime, parsedFile());
+    QVERIFY(cache.value("a.qbs", oldTime) == a);
+    cache.insert("c.qbs", oldTime, parsedFile());
+    QCOMPARE(cache.count(), 2);
+    QVERIFY(cache.value("a.qbs", oldTime) == a);
+    QVERIFY(!cache.value("b.qbs", oldTime));
+    QVERIFY(cache.value("c.qbs", oldTime));
+}
+
 void TestLanguage::baseProperty()
 {
     bool exceptionCaught = false;
@@ -2030,6 +2054,48 @@ void TestLanguage::moduleScope()
 
 }
 
+void TestLanguage::moduleValuesAcrossProducts()
+{
+    bool exceptionCaught = false;
+    try {
+        defaultParameters.setProjectFilePath(testProject("module-values-across-products.qbs"));
+        const TopLevelProjectPtr project = loader->loadProject(defaultParameters);
+        QVERIFY(!!project);
+        const QHash<QString, ResolvedProductPtr> products = productsFromProject(project);
+        QCOMPARE(products.size(), 5);
+        const auto moduleValue = [&products](const QString &productName, const QString &name) {
+            const ResolvedProductPtr product = products.value(productName);
+            return product ? product->moduleProperties->moduleProperty("sharedmod", name)
+                           : QVariant();
+        };
+        const QString dirPrefix = QFileInfo(testProject("module-values-across-products.qbs"))
+                .absolutePath() + '/';
+        for (const QString &productName : QStringList{"p1", "p2", "p3", "p4"}) {
+            const bool factor2 = productName == "p3" || productName == "p4";
+            const int constant = productName == "p4" ? 7 : 42;
+            QCOMPARE(moduleValue(productName, "constant").toInt(), constant);
+            QCOMPARE(moduleValue(productName, "fromOwnProperty").toInt(), constant + 1);
+            QCOMPARE(moduleValue(productName, "fromProduct").toInt(), factor2 ? 4 : 2);
+            QCOMPARE(moduleValue(productName, "paths").toStringList(),
+                     QStringList(dirPrefix + "dir"));
+        }
+
+        // Only p2 can take over the values of p1. The product in the subdirectory has the same
+        // properties as p1, but the path must be resolved relative to its own directory.
+        const double evaluationId = moduleValue("p1", "evaluationId").toDouble();
+        QCOMPARE(moduleValue("p2", "evaluationId").toDouble(), evaluationId);
+        QVERIFY(moduleValue("p3", "evaluationId").toDouble() != evaluationId);
+        QVERIFY(moduleValue("p5", "evaluationId").toDouble() != evaluationId);
+        QCOMPARE(moduleValue("p5", "fromProduct").toInt(), 2);
+        QCOMPARE(moduleValue("p5", "paths").toStringList(),
+                 QStringList(dirPrefix + "module-values-across-products/dir"));
+    } catch (const ErrorInfo &e) {
+        exceptionCaught = true;
+        qDebug() << e.toString();
+    }
+    QCOMPARE(exceptionCaught, false);
+}
+
 void TestLanguage::modules_data()
 {
     QTest::addColumn<QStringList>("expectedModulesInProduct");
@@ -2688,6 +2754,64 @@ void TestLanguage::propertyAssignmentInExportedGroup()
     QCOMPARE(exceptionCaught, false);
 }
 
+void TestLanguage::propertyMapInterning()
+{
+    const auto createMap = [](const QVariant &value) {
+        const PropertyMapPtr map = PropertyMapInternal::create();
+        map->setValue(QVariantMap{{"cpp", QVariantMap{{"defines", QStringList{"A"}},
+                                                      {"optimization", value}}}});
+        return map;
+    };
+    const PropertyMapPtr map1 = createMap("fast");
+    const PropertyMapPtr map2 = createMap("fast");
+    const PropertyMapPtr map3 = createMap("small");
+    PropertyMapInterner interner;
+    QVERIFY(interner.intern(map1) == map1);
+    QVERIFY(interner.intern(map2) == map1);
+    QVERIFY(interner.intern(map3) == map3);
+    QVERIFY(interner.intern(PropertyMapPtr()) == PropertyMapPtr());
+
+    // Maps that are not used anymore get forgotten eventually.
+    for (int i = 0; i < 1000; ++i)
+        interner.intern(createMap(i));
+    QVERIFY2(interner.mapCount() < 200, qPrintable(QString::number(interner.mapCount())));
+}
+
+void TestLanguage::propertyMapModulePropertyLookup()
+{
+    const PropertyMapPtr map = PropertyMapInternal::create();
+    map->setValue(QVariantMap{{"cpp", QVariantMap{{"defines", QStringList{"A"}}}},
+                              {"qbs", QVariantMap{{"targetOS", QStringList{"linux"}}}}});
+    bool isPresent = false;
+    QCOMPARE(map->moduleProperty("cpp", "defines", &isPresent), QVariant(QStringList{"A"}));
+    QVERIFY(isPresent);
+    const ModulePropertyPath targetOS("qbs", "targetOS");
+    QCOMPARE(map->moduleProperty(targetOS, &isPresent), QVariant(QStringList{"linux"}));
+    QVERIFY(isPresent);
+    QCOMPARE(map->moduleProperty("cpp", "targetOS", &isPresent), QVariant());
+    QVERIFY(!isPresent);
+    QCOMPARE(map->moduleProperty("java", "defines", &isPresent), QVariant());
+    QVERIFY(!isPresent);
+
+    // The index must not survive a change of the map.
+    map->setValue(QVariantMap{{"cpp", QVariantMap{{"defines", QStringList{"B"}}}}});
+    QCOMPARE(map->moduleProperty("cpp", "defines", &isPresent), QVariant(QStringList{"B"}));
+    QVERIFY(isPresent);
+    QCOMPARE(map->moduleProperty(targetOS, &isPresent), QVariant());
+    QVERIFY(!isPresent);
+
+    // Interned maps answer from an index that gets filled module by module.
+    PropertyMapInterner interner;
+    const PropertyMapPtr internedMap = interner.intern(map);
+    QCOMPARE(internedMap->moduleProperty("java", "defines", &isPresent), QVariant());
+    QVERIFY(!isPresent);
+    QCOMPARE(internedMap->moduleProperty("cpp", "defines", &isPresent),
+             QVariant(QStringList{"B"}));
+    QVERIFY(isPresent);
+    QCOMPARE(internedMap->moduleProperty(targetOS, &isPresent), QVariant());
+    QVERIFY(!isPresent);
+}
+
 void TestLanguage::qbs1275()
 {
     bool exceptionCaught = false;
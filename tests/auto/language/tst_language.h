@@ -77,6 +77,7 @@ private slots:
     void cleanupTestCase();
 
     void additionalProductTypes();
+    void astCache();
     void baseProperty();
     void baseValidation();
     void brokenDependencyCycle();
@@ -133,6 +134,7 @@ private slots:
     void modulePropertiesInGroups();
     void modulePropertyOverridesPerProduct();
     void moduleScope();
+    void moduleValuesAcrossProducts();
     void modules_data();
     void modules();
     void multiplexedExports();
@@ -157,6 +159,8 @@ private slots:
     void propertiesBlockInGroup();
     void propertiesItemInModule();
     void propertyAssignmentInExportedGroup();
+    void propertyMapInterning();
+    void propertyMapModulePropertyLookup();
     void qbs1275();
     void qbsPropertiesInProjectCondition();
     void qbsPropertyConvenienceOverride();
@@ -44,10 +44,14 @@
 #include "../shared.h"
 
 #include <tools/buildoptions.h>
+#include <tools/dependencyfileparser.h>
 #include <tools/error.h>
 #include <tools/fileinfo.h>
 #include <tools/filesaver.h>
+#include <tools/filestatcache.h>
 #include <tools/hostosinfo.h>
+#include <tools/parallelfor.h>
+#include <tools/persistence.h>
 #include <tools/processutils.h>
 #include <tools/profile.h>
 #include <tools/set.h>
@@ -56,15 +60,20 @@
 #include <tools/stringutils.h>
 #include <tools/version.h>
 
+#include <QtCore/qdatastream.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qsettings.h>
 #include <QtCore/qtemporarydir.h>
 #include <QtCore/qtemporaryfile.h>
+#include <QtCore/qthread.h>
 
 #include <QtTest/qtest.h>
 
+#include <atomic>
+#include <vector>
+
 using namespace qbs;
 using namespace qbs::Internal;
 
@@ -249,6 +258,177 @@ void TestTools::fileCaseCheck()
         QVERIFY(!FileInfo::isFileCaseCorrect(upperFilePath));
 }
 
+void TestTools::fileStatCache()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString dirPath = tempDir.path();
+    const QString filePath = dirPath + "/file.txt";
+    const QString subDirPath = dirPath + "/sub";
+    const QString newFilePath = dirPath + "/new.txt";
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.close();
+    QVERIFY(QDir(dirPath).mkdir("sub"));
+
+    FileStatCache cache;
+    cache.prefetchDirectories({dirPath, dirPath + "/does-not-exist"});
+    QVERIFY(cache.exists(filePath));
+    QCOMPARE(cache.lastModified(filePath), FileInfo(filePath).lastModified());
+    QVERIFY(cache.fileInfo(subDirPath).isDir());
+    QVERIFY(!cache.exists(newFilePath));
+    QVERIFY(cache.exists(subDirPath + "/../file.txt"));
+    QVERIFY(!cache.exists(dirPath + "/does-not-exist/file.txt"));
+
+    // Changes are only seen after invalidation.
+    QFile newFile(newFilePath);
+    QVERIFY(newFile.open(QIODevice::WriteOnly));
+    newFile.close();
+    QVERIFY(!cache.exists(newFilePath));
+    cache.invalidate(newFilePath);
+    QVERIFY(cache.exists(newFilePath));
+    QVERIFY(QFile::remove(filePath));
+    QVERIFY(cache.exists(filePath));
+    cache.clear();
+    QVERIFY(!cache.exists(filePath));
+
+    // Files that were missing before are looked up again once commands can run.
+    const QString sideOutputPath = dirPath + "/side-output.txt";
+    cache.prefetchDirectories({dirPath});
+    QVERIFY(!cache.exists(sideOutputPath));
+    QFile sideOutput(sideOutputPath);
+    QVERIFY(sideOutput.open(QIODevice::WriteOnly));
+    sideOutput.close();
+    QVERIFY(!cache.exists(sideOutputPath));
+    cache.stopCachingMisses();
+    QVERIFY(cache.exists(sideOutputPath));
+    QVERIFY(QFile::remove(sideOutputPath));
+    cache.invalidate(sideOutputPath);
+    QVERIFY(!cache.exists(sideOutputPath));
+    QVERIFY(sideOutput.open(QIODevice::WriteOnly));
+    sideOutput.close();
+    QVERIFY(cache.exists(sideOutputPath));
+}
+
+void TestTools::dependencyFileParser()
+{
+    const QByteArray content = "/out/main.o: /src/main.cpp /src/my\\ header.h \\\n"
+            "  /usr/include/stdio.h \\\r\n"
+            "  C:\\dir\\win.h $$HOME.h a\\#b.h /src/main.cpp\n"
+            "/src/my\\ header.h:\n";
+    const QStringList expected{"/src/main.cpp", "/src/my header.h", "/usr/include/stdio.h",
+                               "C:\\dir\\win.h", "$HOME.h", "a#b.h"};
+    QCOMPARE(parseDependencyFile(content), expected);
+    QCOMPARE(parseDependencyFile(QByteArray()), QStringList());
+}
+
+void TestTools::parallelFor()
+{
+    std::vector<int> results(1000, 0);
+    Internal::parallelFor(results.size(), [&results](std::size_t i) { results[i] = int(i); });
+    for (std::size_t i = 0; i < results.size(); ++i)
+        QCOMPARE(results.at(i), int(i));
+
+    // The first exception is passed on to the caller, and no items are started after it.
+    std::atomic<int> itemsRun(0);
+    bool exceptionCaught = false;
+    try {
+        Internal::parallelFor(1000, [&itemsRun](std::size_t i) {
+            ++itemsRun;
+            if (i == 10)
+                throw ErrorInfo("item 10 failed");
+            QThread::msleep(1);
+        }, 4);
+    } catch (const ErrorInfo &e) {
+        exceptionCaught = true;
+        QCOMPARE(e.toString(), QString("item 10 failed"));
+    }
+    QVERIFY(exceptionCaught);
+    QVERIFY(itemsRun < 1000);
+}
+
+static const QVariantMap persistenceTestConfig{{"key", "value"}};
+static const QStringList persistenceTestList{"one", "two", "one"};
+
+static void checkPersistenceTestData(PersistentPool &pool)
+{
+    QCOMPARE(pool.headData().projectConfig, persistenceTestConfig);
+    QString first;
+    int number = 0;
+    QStringList list;
+    QString empty;
+    QString firstAgain;
+    pool.load(first, number, list, empty, firstAgain);
+    QCOMPARE(first, QString("first"));
+    QCOMPARE(number, 42);
+    QCOMPARE(list, persistenceTestList);
+    QVERIFY(empty.isEmpty());
+    QCOMPARE(firstAgain, QString("first"));
+}
+
+void TestTools::persistentPoolLegacyFormat()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString filePath = tempDir.path() + "/legacy.bg";
+    QFile file(filePath);
+    QVERIFY2(file.open(QIODevice::WriteOnly), qPrintable(file.errorString()));
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_4_8);
+
+    // Strings are stored inline where they first occur, afterwards only their ids.
+    stream << QByteArray("QBSPERSISTENCE-124") << persistenceTestConfig;
+    stream << 0 << QString("first");
+    stream << 42;
+    stream << 0 << 3 << 1 << QString("one") << 2 << QString("two") << 1;
+    stream << -2;
+    stream << 0;
+    file.close();
+
+    Logger logger;
+    PersistentPool pool(logger);
+    pool.load(filePath);
+    QCOMPARE(pool.version(), int(PersistentPool::BaseVersion));
+    checkPersistenceTestData(pool);
+}
+
+void TestTools::persistentPoolMappedFormat()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString filePath = tempDir.path() + "/mapped.bg";
+    Logger logger;
+    {
+        PersistentPool pool(logger);
+        PersistentPool::HeadData headData;
+        headData.projectConfig = persistenceTestConfig;
+        pool.setHeadData(headData);
+        pool.setupWriteStream(filePath);
+        pool.store(QString("first"), 42, persistenceTestList, QString(), QString("first"));
+        pool.finalizeWriteStream();
+    }
+    {
+        PersistentPool pool(logger);
+        pool.load(filePath);
+        QCOMPARE(pool.version(), int(PersistentPool::CurrentVersion));
+        checkPersistenceTestData(pool);
+    }
+
+    // Anything after the index means that the file is corrupt.
+    QFile file(filePath);
+    QVERIFY2(file.open(QIODevice::Append), qPrintable(file.errorString()));
+    file.write("x");
+    file.close();
+    PersistentPool pool(logger);
+    bool exceptionCaught = false;
+    try {
+        pool.load(filePath);
+    } catch (const ErrorInfo &) {
+        exceptionCaught = true;
+    }
+    QVERIFY(exceptionCaught);
+}
+
 void TestTools::testProfiles()
 {
     TemporaryProfile tpp("parent", m_settings);
@@ -63,6 +63,11 @@ private slots:
     void fileSaver();
 
     void fileCaseCheck();
+    void fileStatCache();
+    void dependencyFileParser();
+    void parallelFor();
+    void persistentPoolLegacyFormat();
+    void persistentPoolMappedFormat();
     void testBuildConfigMerging();
     void testFileInfo();
     void testProcessNameByPid();